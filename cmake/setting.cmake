@@ -14,6 +14,11 @@ set(P_LIB_NAME "main2" CACHE STRING "internal lib name" FORCE)
 # test name
 set(P_TEST_NAME "${P_NAME}_test" CACHE STRING "test name" FORCE)
 
+# headless self-play simulator name
+set(P_SIM_NAME "${P_NAME}_simulator" CACHE STRING "simulator name" FORCE)
+# offline solver of small boards (writes the solution database)
+set(P_SOLVER_NAME "${P_NAME}_solver" CACHE STRING "solver name" FORCE)
+
 # ################### Versioning
 set(PRVERSION_MAJOR "0" CACHE STRING "" FORCE)
 set(PRVERSION_MINOR "0" CACHE STRING "" FORCE)
@@ -100,11 +105,18 @@ option(HAS_TEST ON "testing can enabled/disabled")
 # Benchmarking config should be (1 or 0)
 option(HAS_BENCHMARK ON "banchmarking can enabled/disabled")
 
+# headless self-play simulator (needs internal library)
+option(HAS_SIMULATOR ON "simulator can enabled/disabled")
+
+# solution database generator (needs internal library)
+option(HAS_SOLVER ON "solver can enabled/disabled")
+
 # ################### Build Config
 option(HAS_PCH ON "pre compiled header option for increase build speed")
 option(HAS_UNITY_BUILD OFF "unity build should just enabled in release mode")
 
 # ################### Internal Library
+# game needs it (rules engine), just tools/tests can go without it
 option(HAS_LIB ON "internal library can enabled/disabled")
 
 # internal lib type
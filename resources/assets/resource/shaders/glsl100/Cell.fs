@@ -1,13 +1,16 @@
+// merged CircleCell/CrossCell shader of the cell batch (branch on owner)
 #version 100
 
 precision mediump float;
 // Input vertex attributes (from vertex shader)
 varying vec2 fragTexCoord;
 varying vec4 fragColor;
+varying vec4 fragCell;  // x: owner y: seconds since placed z: size in pixels
 // Input uniform values
 uniform vec2  iRes;
 uniform float iTime;
 
+
 vec3 sdgCross(in vec2 p, in vec2 b)
 {
     vec2 s = sign(p);
@@ -22,10 +25,26 @@ vec3 sdgCross(in vec2 p, in vec2 b)
     vec3 r = (h < 0.0 && -q.x < l) ? vec3(-q.x, 0.0, 1.0) : vec3(l, o / l);
     return vec3(sign(h) * r.x, s * ((p.y > p.x) ? r.zy * .1 : r.yz));
 }
-void main()
+
+// https://www.shadertoy.com/view/WfXGWs
+vec4 circleCell(vec2 uv, float edge)
+{
+    vec3  outerColor = vec3(0.678, 0.000, 0.000);
+    float radius     = .3;
+
+    float wave = 0.05 * sin(uv.y * 10.0 + iTime * 3.0) +
+                 0.05 * cos(uv.x * 8.0 + iTime * 7.0);
+
+    radius += wave;
+
+    float dist  = length(uv);
+    float c     = smoothstep(radius + edge, radius, dist);
+    float alpha = mix(0.0, 1.0, c);
+    return vec4(outerColor, 1.0 * alpha);
+}
+
+vec4 crossCell(vec2 uv)
 {
-    vec2 uv = fragTexCoord - .5;
-    // uv.x *= (iRes.x / iRes.y);
     uv *= 2.0;
 
     // size
@@ -44,14 +63,25 @@ void main()
     vec3 col = (d > 0.0) ? vec3(0.0) : vec3(1.0);
     col *= 1.0 + vec3(1.0 * g, 0.1);
     col *= 1. - 1. * exp(-30.0 * abs(d));
-    // col *= 1.0 + 0.5 * cos(360.0 * d);
 
     col *= vec3(0.0, 0.0, 1.0);
-    // col         = mix(col, vec3(1.0), 1.0 - smoothstep(0.0, 0.01, abs(d)));
 
     float alpha = 1.0;
     if (col.r == 0.0 && col.g == 0.0 && col.b == 0.0)
         alpha = 0.0;
+    return vec4(col, 1.0 * alpha);
+}
 
-    gl_FragColor = vec4(col, 1.0 * alpha);
-}
\ No newline at end of file
+void main()
+{
+    // grow from the center when the cell is placed (0.25 s)
+    float grow = clamp(fragCell.y * 4.0, 0.001, 1.0);
+    vec2  uv   = (fragTexCoord - .5) / grow;
+    // soft edge is at least ~1.5 pixels of the cell
+    float edge = max(.025, 1.5 / max(fragCell.z, 1.0));
+
+    if (fragCell.x < 0.5)
+        gl_FragColor = circleCell(uv, edge);
+    else
+        gl_FragColor = crossCell(uv);
+}
@@ -0,0 +1,24 @@
+#version 100
+// raylib default vertex shader + per cell data of the cell batch
+// Input vertex attributes
+attribute vec3 vertexPosition;
+attribute vec2 vertexTexCoord;
+attribute vec4 vertexColor;
+// x: owner (0 circle, 1 cross) y: seconds since placed z: size in pixels
+attribute vec4 vertexTexCoord2;
+
+// Input uniform values
+uniform mat4 mvp;
+
+// Output vertex attributes (to fragment shader)
+varying vec2 fragTexCoord;
+varying vec4 fragColor;
+varying vec4 fragCell;
+
+void main()
+{
+    fragTexCoord = vertexTexCoord;
+    fragColor    = vertexColor;
+    fragCell     = vertexTexCoord2;
+    gl_Position  = mvp * vec4(vertexPosition, 1.0);
+}
@@ -0,0 +1,24 @@
+#version 100
+// raylib default vertex shader + per shape data of the shape batch
+// Input vertex attributes
+attribute vec3 vertexPosition;
+attribute vec2 vertexTexCoord;
+attribute vec4 vertexColor;
+// x: shape and outline y: radius zw: capsule end or rect half size (Shape.fs)
+attribute vec4 vertexTexCoord2;
+
+// Input uniform values
+uniform mat4 mvp;
+
+// Output vertex attributes (to fragment shader)
+varying vec2 fragTexCoord;
+varying vec4 fragColor;
+varying vec4 fragShape;
+
+void main()
+{
+    fragTexCoord = vertexTexCoord;
+    fragColor    = vertexColor;
+    fragShape    = vertexTexCoord2;
+    gl_Position  = mvp * vec4(vertexPosition, 1.0);
+}
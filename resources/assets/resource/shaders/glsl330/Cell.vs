@@ -0,0 +1,24 @@
+#version 330
+// raylib default vertex shader + per cell data of the cell batch
+// Input vertex attributes
+in vec3 vertexPosition;
+in vec2 vertexTexCoord;
+in vec4 vertexColor;
+// x: owner (0 circle, 1 cross) y: seconds since placed z: size in pixels
+in vec4 vertexTexCoord2;
+
+// Input uniform values
+uniform mat4 mvp;
+
+// Output vertex attributes (to fragment shader)
+out vec2 fragTexCoord;
+out vec4 fragColor;
+out vec4 fragCell;
+
+void main()
+{
+    fragTexCoord = vertexTexCoord;
+    fragColor    = vertexColor;
+    fragCell     = vertexTexCoord2;
+    gl_Position  = mvp * vec4(vertexPosition, 1.0);
+}
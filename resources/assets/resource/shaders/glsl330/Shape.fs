@@ -0,0 +1,40 @@
+// circles, capsules and rounded rects of the shape batch (one quad per shape)
+#version 330
+// Input vertex attributes (from vertex shader)
+in vec2 fragTexCoord;  // position in the shape space (layout units)
+in vec4 fragColor;
+// x: sign is the shape (+ capsule, - rounded rect), abs(x) - 1 is the outline
+// thickness (0 => filled) y: radius zw: capsule end or rect half size
+in vec4 fragShape;
+// Input uniform values
+uniform float iPixelScale;  // pixels of the target per layout unit
+
+// Output fragment color
+out vec4 finalColor;
+
+// circle is a capsule with the same start and end (start is the origin)
+float sdCapsule(vec2 p, vec2 end, float radius)
+{
+    float h = clamp(dot(p, end) / max(dot(end, end), 1e-6), 0.0, 1.0);
+    return length(p - (end * h)) - radius;
+}
+
+// rect center is the origin
+float sdRoundRect(vec2 p, vec2 halfSize, float radius)
+{
+    vec2 q = abs(p) - halfSize + radius;
+    return length(max(q, 0.0)) + min(max(q.x, q.y), 0.0) - radius;
+}
+
+void main()
+{
+    float thickness = abs(fragShape.x) - 1.0;
+    float dist      = (fragShape.x > 0.0) ? sdCapsule(fragTexCoord, fragShape.zw, fragShape.y)
+                                          : sdRoundRect(fragTexCoord, fragShape.zw, fragShape.y);
+    // outline is out of the shape (like raylib rounded lines)
+    if (thickness > 0.0)
+        dist = abs(dist - (thickness * 0.5)) - (thickness * 0.5);
+    // one pixel of anti aliasing at any scale
+    float alpha = clamp(0.5 - (dist * iPixelScale), 0.0, 1.0);
+    finalColor  = vec4(fragColor.rgb, fragColor.a * alpha);
+}
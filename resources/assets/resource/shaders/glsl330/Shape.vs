@@ -0,0 +1,24 @@
+#version 330
+// raylib default vertex shader + per shape data of the shape batch
+// Input vertex attributes
+in vec3 vertexPosition;
+in vec2 vertexTexCoord;
+in vec4 vertexColor;
+// x: shape and outline y: radius zw: capsule end or rect half size (Shape.fs)
+in vec4 vertexTexCoord2;
+
+// Input uniform values
+uniform mat4 mvp;
+
+// Output vertex attributes (to fragment shader)
+out vec2 fragTexCoord;
+out vec4 fragColor;
+out vec4 fragShape;
+
+void main()
+{
+    fragTexCoord = vertexTexCoord;
+    fragColor    = vertexColor;
+    fragShape    = vertexTexCoord2;
+    gl_Position  = mvp * vec4(vertexPosition, 1.0);
+}
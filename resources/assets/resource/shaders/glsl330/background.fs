@@ -9,6 +9,8 @@ in vec4 fragColor;
 uniform vec2  iRes;
 uniform float iTime;
 uniform vec3  iColor;
+// cached target pixel => pixel of the half size main target
+uniform float iPixelScale;
 
 // Output fragment color
 out vec4 finalColor;
@@ -49,8 +51,8 @@ vec2 GetPointPosition(vec2 id, vec2 offset)
 void main()
 {
     vec3 resultColor = vec3(0.0);
-    vec2 uv          = gl_FragCoord.xy / iRes.xy;
-    uv               = 30.0 * (gl_FragCoord.xy - 0.5 * iRes.xy) / iRes.y;
+    vec2 fragCoord   = gl_FragCoord.xy * iPixelScale;
+    vec2 uv          = 30.0 * (fragCoord - 0.5 * iRes.xy) / iRes.y;
 
     vec2 id = floor(uv);
     vec2 gv = fract(uv) - 0.5;
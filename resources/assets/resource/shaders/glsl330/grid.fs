@@ -0,0 +1,27 @@
+#version 330
+// grid lines as a distance field over one quad (any columns, rows and size)
+
+// Input vertex attributes (from vertex shader)
+in vec2 fragTexCoord;
+in vec4 fragColor;
+
+// Input uniform values
+uniform vec2  iCells;      // columns, rows
+uniform vec2  iSize;       // quad size in pixels of the render target
+uniform float iThickness;  // line thickness in pixels of the render target
+
+out vec4 finalColor;
+
+void main()
+{
+    vec2 cell    = fragTexCoord * iCells;
+    vec2 nearest = floor(cell + 0.5);
+    // pixels to the nearest line of each axis
+    vec2 toLine  = abs(cell - nearest) * (iSize / iCells);
+    // border lines are not drawn (just the inner ones)
+    vec2 isInner = step(0.5, nearest) * step(nearest, iCells - 0.5);
+    float dist   = min(mix(1e4, toLine.x, isInner.x), mix(1e4, toLine.y, isInner.y));
+    // one pixel of anti aliasing at any resolution
+    float alpha  = clamp((iThickness * 0.5) - dist + 0.5, 0.0, 1.0);
+    finalColor   = vec4(fragColor.rgb, fragColor.a * alpha);
+}
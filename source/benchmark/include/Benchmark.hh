@@ -108,6 +108,15 @@ struct BenchmarkData
     std::size_t threadID {};
 };
 
+// DONT USE IT
+// Needed Data for logging a counter (value over time e.g: step time, job count)
+struct CounterData
+{
+    std::string name;        // Name of the counter
+    double      value {};    // Value at this time
+    long long   time {};     // Same clock as BenchmarkData::startTime
+};
+
 /**
  * DONT USE IT
  * This class using Singleton as DP
@@ -129,6 +138,16 @@ public:
         FileHandle::makeInstance().writeInfo(data);
     }
 
+    /**
+     * This Function creat singleton and write the counter to .json
+     * @param Counter data
+     * @return noreturn
+     */
+    static void startWriteCounter(CounterData const & data) noexcept
+    {
+        FileHandle::makeInstance().writeCounter(data);
+    }
+
     // Deleted members
     FileHandle(FileHandle &&)                  = delete;
     FileHandle(FileHandle const &)             = delete;
@@ -201,6 +220,30 @@ private:
         m_fileStream << "}";
     }
 
+    /**
+     * Add the counter to a .json (chrome://tracing draw it as a graph)
+     * @param  counter data
+     * @return noreturn
+     */
+    void writeCounter(CounterData const & data) noexcept
+    {
+        // Avoid data-race
+        std::lock_guard<std::mutex> lock(m_lock);
+        // Dont write "," in first
+        if (m_counter++ > 0) [[likely]]
+        {
+            m_fileStream << ",";
+        }
+        m_fileStream << "\n{";
+        m_fileStream << R"("cat":"counter",)";
+        m_fileStream << R"("name":")" << data.name << "\",";
+        m_fileStream << R"("ph":"C",)";
+        m_fileStream << R"("pid":0,)";
+        m_fileStream << R"("ts":)" << data.time << ',';
+        m_fileStream << R"("args":{"value":)" << data.value << '}';
+        m_fileStream << "}";
+    }
+
     /**
      * Singleton instance creator
      * @param noparam
@@ -264,4 +307,18 @@ private:
     BenchmarkData m_data = {};
 };
 
+/**
+ * DONT USE IT (use PROFILE_COUNTER)
+ * Write the value of a counter at this time
+ * @param name of the counter and its value
+ * @return noreturn
+ */
+inline void writeCounter(std::string const & name, double const value) noexcept
+{
+    FileHandle::startWriteCounter(CounterData {
+        .name  = name,
+        .value = value,
+        .time  = std::chrono::steady_clock::now().time_since_epoch().count()});
+}
+
 }  // namespace Profiler
\ No newline at end of file
@@ -18,9 +18,13 @@
 // Profile the current scoop use this macro inside { }
 // e.g: {PROFILE_SCOPE(YOUR-NAME);}
 #define PROFILE_SCOPE(NAME) BENCHMARK(NAME)
+// Value of a counter in this time (drawn as a graph)
+// e.g: PROFILE_COUNTER("box2d step ms", profile.step);
+#define PROFILE_COUNTER(NAME, VALUE) Profiler::writeCounter(NAME, VALUE);
 // DONT USE THIS MACRO JUST USE PROFILE and PROFILE_SCOPE
 #define BENCHMARK(NAME) Profiler::BenchMark profile##__LINE__(NAME);
 #else  // Benchmark is OFF replace all above macro with ;
-#define PROFILE()           ;
-#define PROFILE_SCOPE(NAME) ;
+#define PROFILE()                    ;
+#define PROFILE_SCOPE(NAME)          ;
+#define PROFILE_COUNTER(NAME, VALUE) ;
 #endif
\ No newline at end of file
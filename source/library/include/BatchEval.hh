@@ -0,0 +1,70 @@
+/*
+ * Copyright (C) 2024 RealAhani - All Rights Reserved
+ * You may use, distribute and modify this code under the
+ * terms of the MIT license, which unfortunately won't be
+ * written for another century.
+ * You should have received a copy of the MIT license with
+ * this file.
+ */
+
+#pragma once
+
+/**
+ * Win/tie status of many boards in one call (self-play, AI rollouts)
+ * Boards are SoA => first[i] and second[i] are the bitboards of board i
+ * All the win masks are tested on 4 boards (AVX2) or 2 boards (SSE2) at once
+ * and the scalar version give exactly the same result
+ */
+namespace RA_Game
+{
+
+enum class ESimdLevel : u8
+{
+    scalar = 0,
+    sse2,
+    avx2
+};
+
+/*
+ *@Goal: the best simd level that this cpu and build support
+ *@Note: detected once (cpuid) then cached
+ */
+[[nodiscard]]
+auto bestSimdLevel() noexcept -> ESimdLevel;
+
+/*
+ *@Goal: outcome of each board with the given simd level
+ *@Note: level is clamped to bestSimdLevel()
+ *@Note: if both players have a line the board is firstWon (same as scalar)
+ *@Warning: first, second and outOutcomes should have the same size
+ */
+auto evaluateBatch(std::span<u64 const> const first,
+                   std::span<u64 const> const second,
+                   Variant const &            variant,
+                   std::span<EOutcome> const  outOutcomes,
+                   ESimdLevel const           level) noexcept -> void;
+
+/*
+ *@Goal: outcome of each board with the best simd level
+ */
+inline auto evaluateBatch(std::span<u64 const> const first,
+                          std::span<u64 const> const second,
+                          Variant const &            variant,
+                          std::span<EOutcome> const  outOutcomes) noexcept -> void
+{
+    evaluateBatch(first, second, variant, outOutcomes, bestSimdLevel());
+}
+
+/*
+ *@Goal: reference version (one board at a time)
+ */
+inline auto evaluateBatchScalar(std::span<u64 const> const first,
+                                std::span<u64 const> const second,
+                                Variant const &            variant,
+                                std::span<EOutcome> const  outOutcomes) noexcept
+    -> void
+{
+    evaluateBatch(first, second, variant, outOutcomes, ESimdLevel::scalar);
+}
+
+}  // namespace RA_Game
@@ -0,0 +1,141 @@
+/*
+ * Copyright (C) 2024 RealAhani - All Rights Reserved
+ * You may use, distribute and modify this code under the
+ * terms of the MIT license, which unfortunately won't be
+ * written for another century.
+ * You should have received a copy of the MIT license with
+ * this file.
+ */
+
+#pragma once
+
+/**
+ * Rules engine of the game (no raylib/box2d in here)
+ * The whole state of a match is a small POD (Board) and the rules of a
+ * board variant (row/col/goal) are precomputed once in a Variant
+ * so every move is just a few bit operations
+ */
+namespace RA_Game
+{
+
+// a board is a 64bit bitboard per player so 8x8 is the biggest variant
+inline constexpr u8 maxCells    = 64;
+inline constexpr u8 playerCount = 2;
+inline constexpr u8 invalidCell = 0xFF;
+
+enum class EOutcome : u8
+{
+    none = 0,   // game is going on
+    firstWon,   // player with id 0 made a line
+    secondWon,  // player with id 1 made a line
+    tie         // board is full and nobody made a line
+};
+
+/*
+ *@Goal: precomputed rules of a board variant
+ *@Note: cell index is row-major and start from top-left e.g 3x3:
+ * 0 1 2
+ * 3 4 5
+ * 6 7 8
+ *@Note: create it with makeVariant and share it (read-only) between threads
+ */
+struct Variant
+{
+    u8  columnCount {};
+    u8  rowCount {};
+    u8  goal {};       // how many marks in a line is a win
+    u8  cellCount {};  // columnCount * rowCount
+    u64 fullMask {};   // all the cells of the board
+    // all the lines that cause win (old winTable)
+    std::vector<u64> winMasks;
+    // lines that pass through each cell (flat) => for cell n they are in
+    // [cellWinStart[n], cellWinStart[n+1])
+    std::vector<u64>               cellWinMasks;
+    std::array<u16, maxCells + 1> cellWinStart {};
+};
+
+/*
+ *@Goal: compact state of a match (trivially copyable)
+ *@Note: moves[id] is the bitboard of the player with that id
+ */
+struct Board
+{
+    std::array<u64, playerCount> moves {};
+    u8       turn {0};  // id of the player that should move now
+    u8       moveCount {0};
+    u8       lastMove {invalidCell};
+    EOutcome outcome {EOutcome::none};
+};
+static_assert(std::is_trivially_copyable_v<Board>);
+
+/*
+ *@Goal: build the rules (win lines) of a columnCount x rowCount board
+ *@Note: goal should be 2<=goal<=max(col,row) and col*row<=64
+ */
+[[nodiscard]]
+auto makeVariant(u8 const columnCount, u8 const rowCount, u8 const goal) -> Variant;
+
+/*
+ *@Goal: clean the board for a new match (first player start)
+ */
+auto reset(Board & board) noexcept -> void;
+
+/*
+ *@Goal: put the mark of the current player on the cell
+ *@Note: return false and does nothing if the move is not legal
+ */
+[[maybe_unused]]
+auto applyMove(Board & board, Variant const & variant, u8 const cell) noexcept
+    -> bool;
+
+[[nodiscard]]
+inline auto status(Board const & board) noexcept -> EOutcome
+{
+    return board.outcome;
+}
+
+[[nodiscard]]
+inline auto occupied(Board const & board) noexcept -> u64
+{
+    return board.moves[0] | board.moves[1];
+}
+
+[[nodiscard]]
+inline auto isCellFree(Board const & board, u8 const cell) noexcept -> bool
+{
+    return ((occupied(board) >> cell) & u64 {1}) == 0;
+}
+
+/*
+ *@Goal: bitboard of all the empty cells (zero if the game is finished)
+ */
+[[nodiscard]]
+inline auto legalMoves(Board const & board, Variant const & variant) noexcept -> u64
+{
+    if (board.outcome != EOutcome::none)
+        return 0;
+    return variant.fullMask & ~occupied(board);
+}
+
+/*
+ *@Goal: does this bitboard contain any of the win lines
+ */
+[[nodiscard]]
+auto hasLine(u64 const moves, Variant const & variant) noexcept -> bool;
+
+/*
+ *@Goal: does putting a mark on the cell complete a line for these moves
+ *@Note: just check the lines that pass through the cell
+ */
+[[nodiscard]]
+auto makesLine(u64 const moves, u8 const cell, Variant const & variant) noexcept
+    -> bool;
+
+/*
+ *@Goal: return the line that the winner made (zero if nobody won)
+ *@Note: use it for drawing the win animation
+ */
+[[nodiscard]]
+auto winningLine(Board const & board, Variant const & variant) noexcept -> u64;
+
+}  // namespace RA_Game
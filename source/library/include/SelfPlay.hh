@@ -0,0 +1,127 @@
+/*
+ * Copyright (C) 2024 RealAhani - All Rights Reserved
+ * You may use, distribute and modify this code under the
+ * terms of the MIT license, which unfortunately won't be
+ * written for another century.
+ * You should have received a copy of the MIT license with
+ * this file.
+ */
+
+#pragma once
+
+/**
+ * Self-play on top of the rules engine (GameCore.hh)
+ * Policies are plain function pointers so the simulator or the game can
+ * plug any of them for each player
+ */
+namespace RA_Game
+{
+
+/*
+ *@Goal: small and fast random generator (xorshift64*) for self-play
+ *@Note: its not thread safe => use one per thread
+ */
+class FastRandom
+{
+public:
+
+    explicit FastRandom(u64 const seed) noexcept :
+    m_state {(seed != 0) ? seed : 0x9E3779B97F4A7C15ULL}
+    {
+    }
+
+    [[nodiscard]]
+    auto next() noexcept -> u64
+    {
+        m_state ^= m_state >> 12;
+        m_state ^= m_state << 25;
+        m_state ^= m_state >> 27;
+        return m_state * 0x2545F4914F6CDD1DULL;
+    }
+
+    // random number in [0, bound)
+    [[nodiscard]]
+    auto below(u32 const bound) noexcept -> u32
+    {
+        return cast(u32, ((next() >> 32) * bound) >> 32);
+    }
+
+private:
+
+    u64 m_state;
+};
+
+/*
+ *@Goal: a player brain => return the cell that should be played
+ *@Note: it is called only when the game is going on (at least one free cell)
+ */
+using PolicyFn = u8 (*)(Board const &, Variant const &, FastRandom &);
+
+/*
+ *@Goal: pick one of the set bits of the mask randomly
+ *@Warning: mask should not be zero
+ */
+[[nodiscard]]
+auto pickRandomCell(u64 const mask, FastRandom & rng) noexcept -> u8;
+
+// random legal cell
+[[nodiscard]]
+auto randomPolicy(Board const & board, Variant const & variant, FastRandom & rng) noexcept
+    -> u8;
+
+// win if you can, block if you must, otherwise random
+[[nodiscard]]
+auto aiPolicy(Board const & board, Variant const & variant, FastRandom & rng) noexcept
+    -> u8;
+
+/*
+ *@Goal: find the policy by name ("random", "ai", "perfect")
+ *@Note: return nullptr if there is no policy with this name
+ */
+[[nodiscard]]
+auto findPolicy(str_v const name) noexcept -> PolicyFn;
+
+/*
+ *@Goal: aggregated result of many games
+ */
+struct SelfPlayStats
+{
+    u64 games {};
+    u64 firstWins {};
+    u64 secondWins {};
+    u64 ties {};
+    u64 totalMoves {};
+    // how many games finished after n moves
+    std::array<u64, maxCells + 1> lengthHistogram {};
+
+    auto record(Board const & board) noexcept -> void;
+    auto merge(SelfPlayStats const & other) noexcept -> void;
+};
+
+struct SelfPlayConfig
+{
+    PolicyFn first {nullptr};   // policy of player with id 0
+    PolicyFn second {nullptr};  // policy of player with id 1
+    u64      games {};
+    u32      threadCount {1};
+    u64      seed {};
+};
+
+/*
+ *@Goal: play one full match from an empty board
+ */
+[[nodiscard]]
+auto playGame(Variant const & variant,
+              PolicyFn const  first,
+              PolicyFn const  second,
+              FastRandom &    rng) noexcept -> Board;
+
+/*
+ *@Goal: play config.games matches spread on config.threadCount threads
+ *@Note: same seed and thread count => same result
+ */
+[[nodiscard]]
+auto runSelfPlay(Variant const & variant, SelfPlayConfig const & config)
+    -> SelfPlayStats;
+
+}  // namespace RA_Game
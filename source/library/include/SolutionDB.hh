@@ -0,0 +1,205 @@
+/*
+ * Copyright (C) 2024 RealAhani - All Rights Reserved
+ * You may use, distribute and modify this code under the
+ * terms of the MIT license, which unfortunately won't be
+ * written for another century.
+ * You should have received a copy of the MIT license with
+ * this file.
+ */
+
+#pragma once
+
+/**
+ * Precomputed solution of small boards (3x3, 4x4)
+ * The solver tool enumerate and solve every reachable position and write a
+ * sorted table of (canonical position -> value, best move)
+ * The game/AI just mmap that file and binary search it (no parsing, no search)
+ *
+ * file layout (native endian):
+ * SolutionHeader | u64 keys[count] (sorted) | u16 payloads[count]
+ */
+namespace RA_Game
+{
+
+// key is (first << 32 | second) so the board should be at most 32 cells
+inline constexpr u8  maxSolvedCells  = 32;
+inline constexpr u32 solutionMagic   = 0x42445352;  // "RSDB"
+inline constexpr u16 solutionVersion = 1;
+
+struct SolutionHeader
+{
+    u32 magic {solutionMagic};
+    u16 version {solutionVersion};
+    u8  columnCount {};
+    u8  rowCount {};
+    u8  goal {};
+    u8  symmetryCount {};
+    u16 reserved {};
+    u64 count {};  // number of positions
+};
+static_assert(sizeof(SolutionHeader) == 24);
+
+/*
+ *@Goal: result of a position for the player that should move
+ *@Note: value: 1 win, 0 tie, -1 loss (with best play of both players)
+ *@Note: plies is how many moves till the end with best play
+ */
+struct Solution
+{
+    i8 value {};
+    u8 bestMove {invalidCell};  // invalidCell for finished positions
+    u8 plies {};
+};
+
+// payload bits: [0,8) best move | [8,10) value + 1 | [10,16) plies
+[[nodiscard]]
+constexpr auto packSolution(Solution const & solution) noexcept -> u16
+{
+    return cast(u16,
+                solution.bestMove | ((solution.value + 1) << 8) |
+                    ((solution.plies & 0x3F) << 10));
+}
+
+[[nodiscard]]
+constexpr auto unpackSolution(u16 const payload) noexcept -> Solution
+{
+    return Solution {.value    = cast(i8, ((payload >> 8) & 0x3) - 1),
+                     .bestMove = cast(u8, payload & 0xFF),
+                     .plies    = cast(u8, payload >> 10)};
+}
+
+/*
+ *@Goal: board symmetries (4 for rectangle, 8 for square) as cell maps
+ *@Note: byteMap transform a bitboard 8 cells at a time
+ */
+struct Symmetries
+{
+    u8 count {};
+    std::array<std::array<u8, maxSolvedCells>, 8> cellMap {};
+    std::array<std::array<u8, maxSolvedCells>, 8> inverseCellMap {};
+    std::array<std::array<std::array<u32, 256>, 4>, 8> byteMap {};
+};
+
+/*
+ *@Warning: variant.cellCount should be <= maxSolvedCells
+ */
+[[nodiscard]]
+auto makeSymmetries(Variant const & variant) -> Symmetries;
+
+/*
+ *@Goal: smallest key between all the symmetric boards
+ *@Note: outSymmetry is the symmetry that map this board to the canonical one
+ */
+[[nodiscard]]
+auto canonicalKey(u32 const          first,
+                  u32 const          second,
+                  Symmetries const & symmetries,
+                  u8 &               outSymmetry) noexcept -> u64;
+
+/*
+ *@Goal: solve every reachable position of the variant (offline tool)
+ *@Note: return (canonical key, packed solution) sorted by key
+ *@Warning: 4x4 takes seconds, bigger boards are not practical
+ */
+[[nodiscard]]
+auto solveVariant(Variant const & variant) -> std::vector<std::pair<u64, u16>>;
+
+/*
+ *@Goal: write the solved positions as a table that can be mmaped
+ */
+[[nodiscard]]
+auto writeSolutionTable(str const &                              path,
+                        Variant const &                          variant,
+                        std::vector<std::pair<u64, u16>> const & entries) -> bool;
+
+/*
+ *@Goal: read only memory mapped file (posix mmap / win32 file mapping)
+ */
+class MappedFile
+{
+public:
+
+    MappedFile() = default;
+    ~MappedFile();
+
+    // Deleted members
+    MappedFile(MappedFile const &)             = delete;
+    MappedFile & operator=(MappedFile const &) = delete;
+    MappedFile(MappedFile &&)                  = delete;
+    MappedFile & operator=(MappedFile &&)      = delete;
+
+    [[nodiscard]]
+    auto open(str const & path) noexcept -> bool;
+    auto close() noexcept -> void;
+
+    [[nodiscard]]
+    auto data() const noexcept -> std::span<std::byte const>
+    {
+        return {m_data, m_size};
+    }
+
+private:
+
+    std::byte const* m_data {nullptr};
+    std::size_t      m_size {0};
+#if defined(_WIN32)
+    void* m_fileHandle {nullptr};
+    void* m_mappingHandle {nullptr};
+#endif
+};
+
+/*
+ *@Goal: O(log n) lookup of solved positions on top of the mmaped file
+ */
+class SolutionTable
+{
+public:
+
+    SolutionTable() = default;
+
+    /*
+     *@Goal: map the file and check it belongs to this variant
+     *@Note: return false if file is missing, corrupted or for another variant
+     */
+    [[nodiscard]]
+    auto open(str const & path, Variant const & variant) -> bool;
+
+    [[nodiscard]]
+    auto isOpen() const noexcept -> bool
+    {
+        return !m_keys.empty();
+    }
+
+    [[nodiscard]]
+    auto size() const noexcept -> std::size_t
+    {
+        return m_keys.size();
+    }
+
+    /*
+     *@Goal: solution of the board for the player that should move
+     *@Note: bestMove is in the board cell order (not canonical)
+     */
+    [[nodiscard]]
+    auto lookup(Board const & board) const noexcept -> std::optional<Solution>;
+
+private:
+
+    MappedFile           m_file;
+    Symmetries           m_symmetries {};
+    std::span<u64 const> m_keys;
+    std::span<u16 const> m_payloads;
+};
+
+/*
+ *@Goal: table that perfectPolicy use (nullptr => perfectPolicy play like ai)
+ *@Note: table should outlive the games that use it
+ */
+auto bindSolutionTable(SolutionTable const* table) noexcept -> void;
+
+// best move from the bound solution table (ai policy if position is not there)
+[[nodiscard]]
+auto perfectPolicy(Board const & board, Variant const & variant, FastRandom & rng) noexcept
+    -> u8;
+
+}  // namespace RA_Game
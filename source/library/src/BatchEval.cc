@@ -0,0 +1,217 @@
+/*
+ * Copyright (C) 2024 RealAhani - All Rights Reserved
+ * You may use, distribute and modify this code under the
+ * terms of the MIT license, which unfortunately won't be
+ * written for another century.
+ * You should have received a copy of the MIT license with
+ * this file.
+ */
+
+#include "GameCore.hh"
+#include "BatchEval.hh"
+
+// sse2 is the base line of x64 and avx2 is selected in runtime (cpuid)
+#if defined(__SSE2__) && (defined(__x86_64__) || defined(__i386__))
+#define BATCH_EVAL_X86 1
+#include <immintrin.h>
+#else
+#define BATCH_EVAL_X86 0
+#endif
+
+namespace RA_Game
+{
+namespace
+{
+
+/*
+ *@Goal: the only place that decide the outcome => all levels give the same result
+ */
+[[nodiscard]]
+inline auto toOutcome(bool const firstWon, bool const secondWon, bool const isFull) noexcept
+    -> EOutcome
+{
+    if (firstWon)
+        return EOutcome::firstWon;
+    if (secondWon)
+        return EOutcome::secondWon;
+    if (isFull)
+        return EOutcome::tie;
+    return EOutcome::none;
+}
+
+/*
+ *@Goal: one board at a time from begin to the end of the batch
+ */
+auto evaluateScalar(std::span<u64 const> const first,
+                    std::span<u64 const> const second,
+                    Variant const &            variant,
+                    std::span<EOutcome> const  outOutcomes,
+                    std::size_t const          begin) noexcept -> void
+{
+    for (std::size_t i = begin; i < first.size(); ++i)
+    {
+        outOutcomes[i] = toOutcome(hasLine(first[i], variant),
+                                   hasLine(second[i], variant),
+                                   (first[i] | second[i]) == variant.fullMask);
+    }
+}
+
+#if BATCH_EVAL_X86 == 1
+
+// 64bit lane equality in sse2 (_mm_cmpeq_epi64 is sse4.1)
+[[nodiscard]]
+inline auto cmpeq64(__m128i const a, __m128i const b) noexcept -> __m128i
+{
+    __m128i const eq32 = _mm_cmpeq_epi32(a, b);
+    return _mm_and_si128(eq32, _mm_shuffle_epi32(eq32, _MM_SHUFFLE(2, 3, 0, 1)));
+}
+
+/*
+ *@Goal: 2 boards per step
+ *@Note: return how many boards are evaluated (the tail is for scalar)
+ */
+[[nodiscard]]
+auto evaluateSSE2(std::span<u64 const> const first,
+                  std::span<u64 const> const second,
+                  Variant const &            variant,
+                  std::span<EOutcome> const  outOutcomes) noexcept -> std::size_t
+{
+    std::size_t const count = first.size() & ~std::size_t {1};
+    __m128i const     full  = _mm_set1_epi64x(cast(i64, variant.fullMask));
+    for (std::size_t i = 0; i < count; i += 2)
+    {
+        __m128i const f = _mm_loadu_si128(
+            reinterpret_cast<__m128i const*>(first.data() + i));
+        __m128i const s = _mm_loadu_si128(
+            reinterpret_cast<__m128i const*>(second.data() + i));
+        __m128i firstWon  = _mm_setzero_si128();
+        __m128i secondWon = _mm_setzero_si128();
+        for (u64 const mask : variant.winMasks)
+        {
+            __m128i const m = _mm_set1_epi64x(cast(i64, mask));
+            firstWon  = _mm_or_si128(firstWon, cmpeq64(_mm_and_si128(f, m), m));
+            secondWon = _mm_or_si128(secondWon, cmpeq64(_mm_and_si128(s, m), m));
+        }
+        __m128i const isFull = cmpeq64(_mm_or_si128(f, s), full);
+
+        // one bit per lane
+        i32 const firstBits  = _mm_movemask_pd(_mm_castsi128_pd(firstWon));
+        i32 const secondBits = _mm_movemask_pd(_mm_castsi128_pd(secondWon));
+        i32 const fullBits   = _mm_movemask_pd(_mm_castsi128_pd(isFull));
+        for (std::size_t lane = 0; lane < 2; ++lane)
+        {
+            outOutcomes[i + lane] = toOutcome(((firstBits >> lane) & 1) != 0,
+                                              ((secondBits >> lane) & 1) != 0,
+                                              ((fullBits >> lane) & 1) != 0);
+        }
+    }
+    return count;
+}
+
+/*
+ *@Goal: 4 boards per step
+ *@Note: return how many boards are evaluated (the tail is for scalar)
+ *@Warning: call it only if cpu support avx2
+ */
+[[nodiscard]] __attribute__((target("avx2")))
+auto evaluateAVX2(std::span<u64 const> const first,
+                  std::span<u64 const> const second,
+                  Variant const &            variant,
+                  std::span<EOutcome> const  outOutcomes) noexcept -> std::size_t
+{
+    std::size_t const count = first.size() & ~std::size_t {3};
+    __m256i const     full  = _mm256_set1_epi64x(cast(i64, variant.fullMask));
+    for (std::size_t i = 0; i < count; i += 4)
+    {
+        __m256i const f = _mm256_loadu_si256(
+            reinterpret_cast<__m256i const*>(first.data() + i));
+        __m256i const s = _mm256_loadu_si256(
+            reinterpret_cast<__m256i const*>(second.data() + i));
+        __m256i firstWon  = _mm256_setzero_si256();
+        __m256i secondWon = _mm256_setzero_si256();
+        for (u64 const mask : variant.winMasks)
+        {
+            __m256i const m = _mm256_set1_epi64x(cast(i64, mask));
+            firstWon  = _mm256_or_si256(firstWon,
+                                       _mm256_cmpeq_epi64(_mm256_and_si256(f, m), m));
+            secondWon = _mm256_or_si256(secondWon,
+                                        _mm256_cmpeq_epi64(_mm256_and_si256(s, m), m));
+        }
+        __m256i const isFull = _mm256_cmpeq_epi64(_mm256_or_si256(f, s), full);
+
+        // one bit per lane
+        i32 const firstBits  = _mm256_movemask_pd(_mm256_castsi256_pd(firstWon));
+        i32 const secondBits = _mm256_movemask_pd(_mm256_castsi256_pd(secondWon));
+        i32 const fullBits   = _mm256_movemask_pd(_mm256_castsi256_pd(isFull));
+        for (std::size_t lane = 0; lane < 4; ++lane)
+        {
+            outOutcomes[i + lane] = toOutcome(((firstBits >> lane) & 1) != 0,
+                                              ((secondBits >> lane) & 1) != 0,
+                                              ((fullBits >> lane) & 1) != 0);
+        }
+    }
+    return count;
+}
+
+#endif  // BATCH_EVAL_X86
+
+}  // namespace
+
+auto bestSimdLevel() noexcept -> ESimdLevel
+{
+    static ESimdLevel const level = []() -> ESimdLevel
+    {
+#if BATCH_EVAL_X86 == 1
+#if defined(_WIN32)  // no cpu builtins with msvc runtime => compile time only
+#if defined(__AVX2__)
+        return ESimdLevel::avx2;
+#else
+        return ESimdLevel::sse2;
+#endif
+#else
+        __builtin_cpu_init();
+        return (__builtin_cpu_supports("avx2") != 0) ? ESimdLevel::avx2
+                                                     : ESimdLevel::sse2;
+#endif
+#else
+        return ESimdLevel::scalar;
+#endif
+    }();
+    return level;
+}
+
+auto evaluateBatch(std::span<u64 const> const first,
+                   std::span<u64 const> const second,
+                   Variant const &            variant,
+                   std::span<EOutcome> const  outOutcomes,
+                   ESimdLevel const           level) noexcept -> void
+{
+    assert(first.size() == second.size() && first.size() == outOutcomes.size());
+
+    std::size_t done {0};
+#if BATCH_EVAL_X86 == 1
+    switch (std::min(level, bestSimdLevel()))
+    {
+        case ESimdLevel::avx2:
+        {
+            done = evaluateAVX2(first, second, variant, outOutcomes);
+            break;
+        }
+        case ESimdLevel::sse2:
+        {
+            done = evaluateSSE2(first, second, variant, outOutcomes);
+            break;
+        }
+        case ESimdLevel::scalar:
+            [[fallthrough]];
+        default:
+            break;
+    }
+#else
+    (void)level;
+#endif
+    // the tail (or everything on scalar level)
+    evaluateScalar(first, second, variant, outOutcomes, done);
+}
+
+}  // namespace RA_Game
@@ -0,0 +1,138 @@
+/*
+ * Copyright (C) 2024 RealAhani - All Rights Reserved
+ * You may use, distribute and modify this code under the
+ * terms of the MIT license, which unfortunately won't be
+ * written for another century.
+ * You should have received a copy of the MIT license with
+ * this file.
+ */
+
+#include "GameCore.hh"
+
+namespace RA_Game
+{
+
+auto makeVariant(u8 const columnCount, u8 const rowCount, u8 const goal) -> Variant
+{
+    assert(columnCount >= 2 && rowCount >= 2);
+    assert(cast(u16, columnCount * rowCount) <= maxCells);
+    assert(goal >= 2 && goal <= std::max(columnCount, rowCount));
+
+    Variant variant {};
+    variant.columnCount = columnCount;
+    variant.rowCount    = rowCount;
+    variant.goal        = goal;
+    variant.cellCount   = cast(u8, columnCount * rowCount);
+    variant.fullMask    = (variant.cellCount == maxCells)
+                              ? ~u64 {0}
+                              : ((u64 {1} << variant.cellCount) - 1);
+
+    // directions: horizontal, vertical, diagonal, anti-diagonal
+    constexpr std::array<std::pair<i32, i32>, 4> const directions {
+        {{1, 0}, {0, 1}, {1, 1}, {-1, 1}}};
+    for (i32 y = 0; y < rowCount; ++y)
+    {
+        for (i32 x = 0; x < columnCount; ++x)
+        {
+            for (auto const & [dx, dy] : directions)
+            {
+                i32 const endX = x + (dx * (goal - 1));
+                i32 const endY = y + (dy * (goal - 1));
+                if (endX < 0 || endX >= columnCount || endY >= rowCount)
+                    continue;
+                u64 mask {};
+                for (i32 i = 0; i < goal; ++i)
+                {
+                    i32 const cell = ((y + (dy * i)) * columnCount) + x + (dx * i);
+                    mask |= u64 {1} << cell;
+                }
+                variant.winMasks.emplace_back(mask);
+            }
+        }
+    }
+
+    // lines of each cell => only these should be checked after a move
+    variant.cellWinMasks.reserve(variant.winMasks.size() * goal);
+    for (u8 cell = 0; cell < variant.cellCount; ++cell)
+    {
+        variant.cellWinStart[cell] = cast(u16, variant.cellWinMasks.size());
+        for (auto const mask : variant.winMasks)
+        {
+            if ((mask >> cell) & u64 {1})
+                variant.cellWinMasks.emplace_back(mask);
+        }
+    }
+    for (u16 cell = variant.cellCount; cell <= maxCells; ++cell)
+        variant.cellWinStart[cell] = cast(u16, variant.cellWinMasks.size());
+    return variant;
+}
+
+auto reset(Board & board) noexcept -> void
+{
+    board = Board {};
+}
+
+auto applyMove(Board & board, Variant const & variant, u8 const cell) noexcept
+    -> bool
+{
+    if (board.outcome != EOutcome::none || cell >= variant.cellCount ||
+        !isCellFree(board, cell))
+        return false;
+
+    u64 & own = board.moves[board.turn];
+    own |= u64 {1} << cell;
+    ++board.moveCount;
+    board.lastMove = cell;
+
+    // just the lines that pass through this cell can be new
+    if (makesLine(own, cell, variant))
+    {
+        board.outcome = (board.turn == 0) ? EOutcome::firstWon
+                                          : EOutcome::secondWon;
+        return true;
+    }
+    if (board.moveCount == variant.cellCount)
+    {
+        board.outcome = EOutcome::tie;
+        return true;
+    }
+    board.turn ^= 1;
+    return true;
+}
+
+auto hasLine(u64 const moves, Variant const & variant) noexcept -> bool
+{
+    return std::ranges::any_of(variant.winMasks,
+                               [moves](u64 const mask)
+                               {
+                                   return (moves & mask) == mask;
+                               });
+}
+
+auto makesLine(u64 const moves, u8 const cell, Variant const & variant) noexcept
+    -> bool
+{
+    u64 const withCell = moves | (u64 {1} << cell);
+    for (u16 i = variant.cellWinStart[cell]; i < variant.cellWinStart[cell + 1]; ++i)
+    {
+        u64 const mask = variant.cellWinMasks[i];
+        if ((withCell & mask) == mask)
+            return true;
+    }
+    return false;
+}
+
+auto winningLine(Board const & board, Variant const & variant) noexcept -> u64
+{
+    if (board.outcome != EOutcome::firstWon && board.outcome != EOutcome::secondWon)
+        return 0;
+    u64 const moves = board.moves[(board.outcome == EOutcome::firstWon) ? 0 : 1];
+    for (auto const mask : variant.winMasks)
+    {
+        if ((moves & mask) == mask)
+            return mask;
+    }
+    return 0;
+}
+
+}  // namespace RA_Game
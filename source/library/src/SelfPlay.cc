@@ -0,0 +1,157 @@
+/*
+ * Copyright (C) 2024 RealAhani - All Rights Reserved
+ * You may use, distribute and modify this code under the
+ * terms of the MIT license, which unfortunately won't be
+ * written for another century.
+ * You should have received a copy of the MIT license with
+ * this file.
+ */
+
+#include "GameCore.hh"
+#include "SelfPlay.hh"
+#include "SolutionDB.hh"
+
+namespace RA_Game
+{
+
+auto pickRandomCell(u64 mask, FastRandom & rng) noexcept -> u8
+{
+    assert(mask != 0);
+    // drop n lowest set bits then the lowest one is the random cell
+    u32 skip = rng.below(cast(u32, std::popcount(mask)));
+    while (skip-- > 0)
+        mask &= mask - 1;
+    return cast(u8, std::countr_zero(mask));
+}
+
+auto randomPolicy(Board const & board, Variant const & variant, FastRandom & rng) noexcept
+    -> u8
+{
+    return pickRandomCell(legalMoves(board, variant), rng);
+}
+
+auto aiPolicy(Board const & board, Variant const & variant, FastRandom & rng) noexcept
+    -> u8
+{
+    u64 const free     = legalMoves(board, variant);
+    u64 const own      = board.moves[board.turn];
+    u64 const opponent = board.moves[board.turn ^ 1];
+
+    // win now
+    for (u64 cells = free; cells != 0; cells &= cells - 1)
+    {
+        auto const cell = cast(u8, std::countr_zero(cells));
+        if (makesLine(own, cell, variant))
+            return cell;
+    }
+    // block the opponent line
+    for (u64 cells = free; cells != 0; cells &= cells - 1)
+    {
+        auto const cell = cast(u8, std::countr_zero(cells));
+        if (makesLine(opponent, cell, variant))
+            return cell;
+    }
+    return pickRandomCell(free, rng);
+}
+
+auto findPolicy(str_v const name) noexcept -> PolicyFn
+{
+    if (name == "random")
+        return &randomPolicy;
+    if (name == "ai")
+        return &aiPolicy;
+    if (name == "perfect")
+        return &perfectPolicy;
+    return nullptr;
+}
+
+auto SelfPlayStats::record(Board const & board) noexcept -> void
+{
+    ++games;
+    totalMoves += board.moveCount;
+    ++lengthHistogram[board.moveCount];
+    switch (board.outcome)
+    {
+        case EOutcome::firstWon:
+        {
+            ++firstWins;
+            break;
+        }
+        case EOutcome::secondWon:
+        {
+            ++secondWins;
+            break;
+        }
+        case EOutcome::tie:
+        {
+            ++ties;
+            break;
+        }
+        case EOutcome::none:
+            [[fallthrough]];
+        default:
+            break;
+    }
+}
+
+auto SelfPlayStats::merge(SelfPlayStats const & other) noexcept -> void
+{
+    games += other.games;
+    firstWins += other.firstWins;
+    secondWins += other.secondWins;
+    ties += other.ties;
+    totalMoves += other.totalMoves;
+    for (std::size_t i = 0; i < lengthHistogram.size(); ++i)
+        lengthHistogram[i] += other.lengthHistogram[i];
+}
+
+auto playGame(Variant const & variant,
+              PolicyFn const  first,
+              PolicyFn const  second,
+              FastRandom &    rng) noexcept -> Board
+{
+    std::array<PolicyFn, playerCount> const policies {first, second};
+    Board board {};
+    while (status(board) == EOutcome::none)
+    {
+        u8 const cell = policies[board.turn](board, variant, rng);
+        [[maybe_unused]] bool const isLegal = applyMove(board, variant, cell);
+        assert(isLegal);
+    }
+    return board;
+}
+
+auto runSelfPlay(Variant const & variant, SelfPlayConfig const & config)
+    -> SelfPlayStats
+{
+    assert(config.first != nullptr && config.second != nullptr);
+    u32 const threadCount = std::max(config.threadCount, 1U);
+
+    // each thread fill its own stats then merge them at the end (no sharing)
+    std::vector<SelfPlayStats> threadStats(threadCount);
+    std::vector<std::thread>   workers;
+    workers.reserve(threadCount);
+    for (u32 t = 0; t < threadCount; ++t)
+    {
+        u64 const games = (config.games / threadCount) +
+                          ((t < (config.games % threadCount)) ? 1 : 0);
+        workers.emplace_back(
+            [&variant, &config, &threadStats, t, games]()
+            {
+                FastRandom    rng {config.seed + (0x9E3779B97F4A7C15ULL * (t + 1))};
+                SelfPlayStats local {};
+                for (u64 i = 0; i < games; ++i)
+                    local.record(playGame(variant, config.first, config.second, rng));
+                threadStats[t] = local;
+            });
+    }
+    SelfPlayStats total {};
+    for (u32 t = 0; t < threadCount; ++t)
+    {
+        workers[t].join();
+        total.merge(threadStats[t]);
+    }
+    return total;
+}
+
+}  // namespace RA_Game
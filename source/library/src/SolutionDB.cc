@@ -0,0 +1,403 @@
+/*
+ * Copyright (C) 2024 RealAhani - All Rights Reserved
+ * You may use, distribute and modify this code under the
+ * terms of the MIT license, which unfortunately won't be
+ * written for another century.
+ * You should have received a copy of the MIT license with
+ * this file.
+ */
+
+#include "GameCore.hh"
+#include "SelfPlay.hh"
+#include "SolutionDB.hh"
+
+#include <cstring>
+#include <unordered_map>
+
+#if defined(_WIN32)
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace RA_Game
+{
+namespace
+{
+
+[[nodiscard]]
+inline auto makeKey(u32 const first, u32 const second) noexcept -> u64
+{
+    return (cast(u64, first) << 32) | second;
+}
+
+[[nodiscard]]
+inline auto transform(u32 const bits, Symmetries const & symmetries, u8 const symmetry) noexcept
+    -> u32
+{
+    auto const & byteMap = symmetries.byteMap[symmetry];
+    return byteMap[0][bits & 0xFF] | byteMap[1][(bits >> 8) & 0xFF] |
+           byteMap[2][(bits >> 16) & 0xFF] | byteMap[3][bits >> 24];
+}
+
+/*
+ *@Goal: negamax over every reachable position with a memo on canonical keys
+ *@Note: no pruning => every child is solved and ends up in the table
+ */
+class Solver
+{
+public:
+
+    explicit Solver(Variant const & variant)
+        : m_variant {variant}, m_symmetries {makeSymmetries(variant)}
+    {}
+
+    /*
+     *@Goal: solution for the player that should move
+     *@Note: bestMove is in the cell order of (first, second)
+     */
+    auto solve(u32 const first, u32 const second) -> Solution
+    {
+        u8        symmetry {};
+        u64 const key = canonicalKey(first, second, m_symmetries, symmetry);
+        if (auto const found = m_memo.find(key); found != m_memo.end())
+        {
+            Solution solution = unpackSolution(found->second);
+            if (solution.bestMove != invalidCell)
+                solution.bestMove = m_symmetries.inverseCellMap[symmetry][solution.bestMove];
+            return solution;
+        }
+
+        bool const isFirstTurn = std::popcount(first) == std::popcount(second);
+        u32 const  opponent    = isFirstTurn ? second : first;
+        u32 const  occupied    = first | second;
+
+        Solution best {};
+        if (hasLine(opponent, m_variant))
+            best = Solution {.value = -1, .bestMove = invalidCell, .plies = 0};
+        else if (occupied == m_variant.fullMask)
+            best = Solution {.value = 0, .bestMove = invalidCell, .plies = 0};
+        else
+        {
+            best.value = -2;  // any move is better than this
+            for (u8 cell = 0; cell < m_variant.cellCount; ++cell)
+            {
+                u32 const bit = 1U << cell;
+                if ((occupied & bit) != 0)
+                    continue;
+                Solution const child = isFirstTurn ? solve(first | bit, second)
+                                                   : solve(first, second | bit);
+                auto const     value = cast(i8, -child.value);
+                auto const     plies = cast(u8, child.plies + 1);
+
+                // win fast, lose slow
+                bool const isBetter = (value > best.value) ||
+                                      (value == best.value &&
+                                       ((value > 0 && plies < best.plies) ||
+                                        (value < 0 && plies > best.plies)));
+                if (isBetter)
+                    best = Solution {.value = value, .bestMove = cell, .plies = plies};
+            }
+        }
+
+        Solution stored = best;
+        if (stored.bestMove != invalidCell)
+            stored.bestMove = m_symmetries.cellMap[symmetry][stored.bestMove];
+        m_memo.emplace(key, packSolution(stored));
+        return best;
+    }
+
+    [[nodiscard]]
+    auto sortedEntries() const -> std::vector<std::pair<u64, u16>>
+    {
+        std::vector<std::pair<u64, u16>> entries {m_memo.begin(), m_memo.end()};
+        std::ranges::sort(entries, {}, &std::pair<u64, u16>::first);
+        return entries;
+    }
+
+private:
+
+    Variant const &                 m_variant;
+    Symmetries const                m_symmetries;
+    std::unordered_map<u64, u16>    m_memo;
+};
+
+SolutionTable const* g_boundTable {nullptr};
+
+}  // namespace
+
+auto makeSymmetries(Variant const & variant) -> Symmetries
+{
+    assert(variant.cellCount <= maxSolvedCells);
+    u8 const   columns  = variant.columnCount;
+    u8 const   rows     = variant.rowCount;
+    bool const isSquare = columns == rows;
+
+    // (x, y) -> (x', y') of each symmetry
+    using MapFn = std::pair<u8, u8> (*)(u8, u8, u8, u8);
+    constexpr std::array<MapFn, 8> const maps {
+        [](u8 x, u8 y, u8, u8) { return std::pair<u8, u8> {x, y}; },
+        [](u8 x, u8 y, u8 c, u8) { return std::pair<u8, u8> {cast(u8, c - 1 - x), y}; },
+        [](u8 x, u8 y, u8, u8 r) { return std::pair<u8, u8> {x, cast(u8, r - 1 - y)}; },
+        [](u8 x, u8 y, u8 c, u8 r)
+        { return std::pair<u8, u8> {cast(u8, c - 1 - x), cast(u8, r - 1 - y)}; },
+        // square only
+        [](u8 x, u8 y, u8, u8) { return std::pair<u8, u8> {y, x}; },
+        [](u8 x, u8 y, u8 c, u8) { return std::pair<u8, u8> {cast(u8, c - 1 - y), x}; },
+        [](u8 x, u8 y, u8 c, u8) { return std::pair<u8, u8> {y, cast(u8, c - 1 - x)}; },
+        [](u8 x, u8 y, u8 c, u8)
+        { return std::pair<u8, u8> {cast(u8, c - 1 - y), cast(u8, c - 1 - x)}; }};
+
+    Symmetries symmetries {};
+    symmetries.count = isSquare ? 8 : 4;
+    for (u8 s = 0; s < symmetries.count; ++s)
+    {
+        for (u8 cell = 0; cell < variant.cellCount; ++cell)
+        {
+            auto const [x, y] = maps[s](cast(u8, cell % columns),
+                                        cast(u8, cell / columns),
+                                        columns,
+                                        rows);
+            u8 const mapped                    = cast(u8, y * columns + x);
+            symmetries.cellMap[s][cell]          = mapped;
+            symmetries.inverseCellMap[s][mapped] = cell;
+        }
+        for (u32 byte = 0; byte < 4; ++byte)
+        {
+            for (u32 value = 0; value < 256; ++value)
+            {
+                u32 bits {0};
+                for (u32 bit = 0; bit < 8; ++bit)
+                {
+                    u32 const cell = byte * 8 + bit;
+                    if ((value & (1U << bit)) != 0 && cell < variant.cellCount)
+                        bits |= 1U << symmetries.cellMap[s][cell];
+                }
+                symmetries.byteMap[s][byte][value] = bits;
+            }
+        }
+    }
+    return symmetries;
+}
+
+auto canonicalKey(u32 const          first,
+                  u32 const          second,
+                  Symmetries const & symmetries,
+                  u8 &               outSymmetry) noexcept -> u64
+{
+    u64 best    = makeKey(first, second);
+    outSymmetry = 0;
+    for (u8 s = 1; s < symmetries.count; ++s)
+    {
+        u64 const key = makeKey(transform(first, symmetries, s),
+                                transform(second, symmetries, s));
+        if (key < best)
+        {
+            best        = key;
+            outSymmetry = s;
+        }
+    }
+    return best;
+}
+
+auto solveVariant(Variant const & variant) -> std::vector<std::pair<u64, u16>>
+{
+    assert(variant.cellCount <= maxSolvedCells);
+    Solver solver {variant};
+    (void)solver.solve(0, 0);
+    return solver.sortedEntries();
+}
+
+auto writeSolutionTable(str const &                              path,
+                        Variant const &                          variant,
+                        std::vector<std::pair<u64, u16>> const & entries) -> bool
+{
+    SolutionHeader const header {.columnCount   = variant.columnCount,
+                                 .rowCount      = variant.rowCount,
+                                 .goal          = variant.goal,
+                                 .symmetryCount = makeSymmetries(variant).count,
+                                 .count         = entries.size()};
+
+    // SoA => keys are packed for the binary search
+    std::vector<u64> keys;
+    std::vector<u16> payloads;
+    keys.reserve(entries.size());
+    payloads.reserve(entries.size());
+    for (auto const & [key, payload] : entries)
+    {
+        keys.push_back(key);
+        payloads.push_back(payload);
+    }
+
+    std::ofstream file {path, std::ios::binary | std::ios::trunc};
+    if (!file.is_open())
+        return false;
+    file.write(reinterpret_cast<char const*>(&header), sizeof(header));
+    file.write(reinterpret_cast<char const*>(keys.data()),
+               cast(std::streamsize, keys.size() * sizeof(u64)));
+    file.write(reinterpret_cast<char const*>(payloads.data()),
+               cast(std::streamsize, payloads.size() * sizeof(u16)));
+    return file.good();
+}
+
+MappedFile::~MappedFile()
+{
+    close();
+}
+
+auto MappedFile::open(str const & path) noexcept -> bool
+{
+    close();
+#if defined(_WIN32)
+    m_fileHandle = CreateFileA(path.c_str(),
+                               GENERIC_READ,
+                               FILE_SHARE_READ,
+                               nullptr,
+                               OPEN_EXISTING,
+                               FILE_ATTRIBUTE_NORMAL,
+                               nullptr);
+    if (m_fileHandle == INVALID_HANDLE_VALUE)
+    {
+        m_fileHandle = nullptr;
+        return false;
+    }
+    LARGE_INTEGER fileSize {};
+    if (GetFileSizeEx(m_fileHandle, &fileSize) == 0 || fileSize.QuadPart == 0)
+    {
+        close();
+        return false;
+    }
+    m_mappingHandle = CreateFileMappingA(m_fileHandle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (m_mappingHandle == nullptr)
+    {
+        close();
+        return false;
+    }
+    void* const view = MapViewOfFile(m_mappingHandle, FILE_MAP_READ, 0, 0, 0);
+    if (view == nullptr)
+    {
+        close();
+        return false;
+    }
+    m_data = static_cast<std::byte const*>(view);
+    m_size = cast(std::size_t, fileSize.QuadPart);
+#else
+    int const fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0)
+        return false;
+    struct stat info {};
+    if (::fstat(fd, &info) != 0 || info.st_size <= 0)
+    {
+        ::close(fd);
+        return false;
+    }
+    auto const size = cast(std::size_t, info.st_size);
+    void* const view = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);  // mapping keep the file alive
+    if (view == MAP_FAILED)
+        return false;
+    m_data = static_cast<std::byte const*>(view);
+    m_size = size;
+#endif
+    return true;
+}
+
+auto MappedFile::close() noexcept -> void
+{
+#if defined(_WIN32)
+    if (m_data != nullptr)
+        UnmapViewOfFile(m_data);
+    if (m_mappingHandle != nullptr)
+        CloseHandle(m_mappingHandle);
+    if (m_fileHandle != nullptr)
+        CloseHandle(m_fileHandle);
+    m_mappingHandle = nullptr;
+    m_fileHandle    = nullptr;
+#else
+    if (m_data != nullptr)
+        ::munmap(const_cast<std::byte*>(m_data), m_size);
+#endif
+    m_data = nullptr;
+    m_size = 0;
+}
+
+auto SolutionTable::open(str const & path, Variant const & variant) -> bool
+{
+    m_keys     = {};
+    m_payloads = {};
+    if (variant.cellCount > maxSolvedCells || !m_file.open(path))
+        return false;
+
+    auto const bytes = m_file.data();
+    if (bytes.size() < sizeof(SolutionHeader))
+    {
+        m_file.close();
+        return false;
+    }
+    SolutionHeader header {};
+    std::memcpy(&header, bytes.data(), sizeof(header));
+    if (header.magic != solutionMagic || header.version != solutionVersion ||
+        header.columnCount != variant.columnCount || header.rowCount != variant.rowCount ||
+        header.goal != variant.goal ||
+        bytes.size() != sizeof(header) + header.count * (sizeof(u64) + sizeof(u16)))
+    {
+        m_file.close();
+        return false;
+    }
+
+    // the header is 24 bytes and mmap is page aligned => keys are 8 bytes aligned
+    auto const count = cast(std::size_t, header.count);
+    auto const* keys = reinterpret_cast<u64 const*>(bytes.data() + sizeof(header));
+    m_keys           = {keys, count};
+    m_payloads       = {reinterpret_cast<u16 const*>(keys + count), count};
+    m_symmetries     = makeSymmetries(variant);
+    return true;
+}
+
+auto SolutionTable::lookup(Board const & board) const noexcept -> std::optional<Solution>
+{
+    if (!isOpen())
+        return std::nullopt;
+    u8        symmetry {};
+    u64 const key   = canonicalKey(cast(u32, board.moves[0]),
+                                 cast(u32, board.moves[1]),
+                                 m_symmetries,
+                                 symmetry);
+    auto const found = std::ranges::lower_bound(m_keys, key);
+    if (found == m_keys.end() || *found != key)
+        return std::nullopt;
+
+    Solution solution = unpackSolution(
+        m_payloads[cast(std::size_t, found - m_keys.begin())]);
+    if (solution.bestMove != invalidCell)
+        solution.bestMove = m_symmetries.inverseCellMap[symmetry][solution.bestMove];
+    return solution;
+}
+
+auto bindSolutionTable(SolutionTable const* table) noexcept -> void
+{
+    g_boundTable = table;
+}
+
+auto perfectPolicy(Board const & board, Variant const & variant, FastRandom & rng) noexcept
+    -> u8
+{
+    if (g_boundTable != nullptr)
+    {
+        if (auto const solution = g_boundTable->lookup(board);
+            solution.has_value() && solution->bestMove != invalidCell)
+            return solution->bestMove;
+    }
+    return aiPolicy(board, variant, rng);
+}
+
+}  // namespace RA_Game
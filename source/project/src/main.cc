@@ -1,3 +1,10 @@
+// gl loader of the platform (raylib link it), used by the shader binary cache
+#if defined(PLATFORM_DESKTOP)
+extern "C" auto glfwGetProcAddress(char const* name) -> void (*)();
+#elif defined(PLATFORM_ANDROID)
+extern "C" auto eglGetProcAddress(char const* name) -> void (*)();
+#endif
+
 namespace
 {
 using namespace std::string_literals;
@@ -63,7 +70,369 @@ auto pathToFile(str_v const fileName, EFileType const fileType) -> str
     return path;
 }
 
+/*
+ *@Goal: startup options (default: borderless window on the monitor)
+ *@Note: headless => hidden window of width x height that auto play and quit
+ * after frameCount frames with the frame time stats (software GL on CI)
+ */
+struct LaunchOptions
+{
+    bool isHeadless {false};
+    u32  frameCount {600};
+    u32  width {1920};
+    u32  height {1080};
+    str  recordPath {};  // input of the run is written here
+    str  replayPath {};  // input of the run is read from here
+};
+
+[[maybe_unused]]
+auto printUsage() noexcept -> void
+{
+    std::cout << "usage: game [--headless] [--frames n] [--width n] [--height n] "
+                 "[--record path | --replay path]\n";
+}
+
+/*
+ *@Goal: parse a positive number from cli argument
+ */
+[[nodiscard]] [[maybe_unused]]
+auto parseNumber(str_v const text, u32 & outValue) noexcept -> bool
+{
+    u32 value {};
+    auto const [ptr, ec] = std::from_chars(text.data(), text.data() + text.size(), value);
+    if (ec != std::errc {} || ptr != text.data() + text.size() || value == 0)
+        return false;
+    outValue = value;
+    return true;
+}
+
+/*
+ *@Goal: fill the options from cli args
+ *@Note: return nullopt if some args are not valid
+ */
+[[nodiscard]] [[maybe_unused]]
+auto parseLaunchOptions(std::span<char*> const args) -> std::optional<LaunchOptions>
+{
+    LaunchOptions options {};
+    for (std::size_t i = 1; i < args.size(); ++i)
+    {
+        str_v const key = args[i];
+        if (key == "--headless"sv)
+        {
+            options.isHeadless = true;
+            continue;
+        }
+        if (key == "--help"sv || (i + 1) >= args.size())
+            return std::nullopt;
+        str_v const value = args[++i];
+
+        bool isValid {true};
+        if (key == "--frames"sv)
+            isValid = parseNumber(value, options.frameCount);
+        else if (key == "--width"sv)
+            isValid = parseNumber(value, options.width);
+        else if (key == "--height"sv)
+            isValid = parseNumber(value, options.height);
+        else if (key == "--record"sv)
+            options.recordPath = value;
+        else if (key == "--replay"sv)
+            options.replayPath = value;
+        else
+            isValid = false;
+
+        if (!isValid)
+        {
+            std::cerr << "Error: invalid argument " << key << ' ' << value << '\n';
+            return std::nullopt;
+        }
+    }
+    if (!options.recordPath.empty() && !options.replayPath.empty())
+    {
+        std::cerr << "Error: --record and --replay can not be used together\n";
+        return std::nullopt;
+    }
+    return options;
+}
+
 }  // namespace RA_Global
+namespace RA_Shader
+{
+// GL entry points of the program binary cache (rlgl does not expose them)
+using GLGetProgramBinary = void (*)(u32, i32, i32*, u32*, void*);
+using GLProgramBinary    = void (*)(u32, u32, void const*, i32);
+using GLGetProgramiv     = void (*)(u32, u32, i32*);
+using GLGetIntegerv      = void (*)(u32, i32*);
+using GLGetString        = unsigned char const* (*)(u32);
+using GLCreateProgram    = u32 (*)();
+using GLDeleteProgram    = void (*)(u32);
+
+constexpr u32 const glVendor                   = 0x1F00;
+constexpr u32 const glRenderer                 = 0x1F01;
+constexpr u32 const glVersion                  = 0x1F02;
+constexpr u32 const glLinkStatus               = 0x8B82;
+constexpr u32 const glProgramBinaryLength      = 0x8741;
+constexpr u32 const glNumProgramBinaryFormats  = 0x87FE;
+constexpr u32 const binaryMagic                = 0x42535852;  // "RXSB"
+inline static constexpr str_v const cacheFilePrefix = "shadercache_"sv;
+
+/*
+ *@Goal: header of a cached program binary file (native endian)
+ *@Note: file is header | binary[size]
+ */
+struct BinaryHeader
+{
+    u32 magic {binaryMagic};
+    u32 format {};  // driver specific binary format
+    u64 sourceHash {};
+    u64 driverHash {};  // vendor | renderer | version string
+    u32 size {};
+    u32 reserved {};
+};
+static_assert(sizeof(BinaryHeader) == 32);
+
+/*
+ *@Goal: shader loader with linked programs cached on disk
+ *@Note: binary is used only if both source hash and driver hash are the same
+ * and the driver link it again, otherwise compile from source and overwrite
+ *@Note: no api or no binary format (Mesa llvmpipe without shader cache, web)
+ * => always compile from source (isSupported is false)
+ */
+struct ShaderCache
+{
+    GLGetProgramBinary getProgramBinary {nullptr};
+    GLProgramBinary    programBinary {nullptr};
+    GLGetProgramiv     getProgramiv {nullptr};
+    GLCreateProgram    createProgram {nullptr};
+    GLDeleteProgram    deleteProgram {nullptr};
+    str                directory {};
+    u64                driverHash {0};
+    bool               isSupported {false};
+    u32                hitCount {0};
+    u32                missCount {0};
+};
+
+/*
+ *@Goal: FNV-1a 64 (cache keys, not for security)
+ */
+[[nodiscard]] [[maybe_unused]]
+constexpr auto hashText(str_v const text, u64 hash = 0xCBF29CE484222325ULL) noexcept -> u64
+{
+    for (char const c : text)
+    {
+        hash ^= cast(u8, c);
+        hash *= 0x100000001B3ULL;
+    }
+    return hash;
+}
+
+/*
+ *@Note: isBinaryApi => gles2 has it as OES_get_program_binary (name + OES),
+ * core functions keep their plain names
+ */
+[[nodiscard]] [[maybe_unused]]
+auto loadProc(char const* name, bool const isBinaryApi = false) noexcept -> void (*)()
+{
+#if defined(PLATFORM_DESKTOP)
+    (void)isBinaryApi;
+    return glfwGetProcAddress(name);
+#elif defined(PLATFORM_ANDROID)
+    return eglGetProcAddress(isBinaryApi ? TextFormat("%sOES", name) : name);
+#else
+    (void)name;
+    (void)isBinaryApi;
+    return nullptr;
+#endif
+}
+
+/*
+ *@Goal: resolve the program binary api of the current context
+ *@Warning: call it after InitWindow (needs the gl context)
+ */
+[[nodiscard]] [[maybe_unused]]
+auto makeShaderCache() -> ShaderCache
+{
+    ShaderCache cache {
+        .getProgramBinary = reinterpret_cast<GLGetProgramBinary>(
+            loadProc("glGetProgramBinary", true)),
+        .programBinary = reinterpret_cast<GLProgramBinary>(loadProc("glProgramBinary", true)),
+        .getProgramiv     = reinterpret_cast<GLGetProgramiv>(loadProc("glGetProgramiv")),
+        .createProgram    = reinterpret_cast<GLCreateProgram>(loadProc("glCreateProgram")),
+        .deleteProgram    = reinterpret_cast<GLDeleteProgram>(loadProc("glDeleteProgram"))};
+#if defined(PLATFORM_DESKTOP)
+    cache.directory = GetApplicationDirectory();
+#endif  // android: relative file => raylib write it on internal data path
+
+    auto const getIntegerv = reinterpret_cast<GLGetIntegerv>(loadProc("glGetIntegerv"));
+    auto const getString   = reinterpret_cast<GLGetString>(loadProc("glGetString"));
+    if (cache.getProgramBinary == nullptr || cache.programBinary == nullptr ||
+        cache.getProgramiv == nullptr || cache.createProgram == nullptr ||
+        cache.deleteProgram == nullptr || getIntegerv == nullptr || getString == nullptr)
+        return cache;
+
+    // extension can be there without any format (Mesa with disabled shader cache)
+    i32 formatCount {0};
+    getIntegerv(glNumProgramBinaryFormats, &formatCount);
+    if (formatCount <= 0)
+        return cache;
+
+    // binary of another driver (or another version of it) is never loaded
+    for (u32 const name : {glVendor, glRenderer, glVersion})
+    {
+        unsigned char const* const text = getString(name);
+        if (text == nullptr)
+            return cache;
+        cache.driverHash = hashText(reinterpret_cast<char const*>(text), cache.driverHash);
+    }
+    cache.isSupported = true;
+    return cache;
+}
+
+/*
+ *@Goal: shader locations of a program like LoadShader set them
+ *@Note: locs is freed by UnloadShader
+ */
+[[nodiscard]] [[maybe_unused]]
+auto makeShader(u32 const id) -> Shader
+{
+    Shader shader {.id = id, .locs = cast(int*, RL_CALLOC(RL_MAX_SHADER_LOCATIONS, sizeof(int)))};
+    std::fill_n(shader.locs, RL_MAX_SHADER_LOCATIONS, -1);
+    shader.locs[SHADER_LOC_VERTEX_POSITION]   = rlGetLocationAttrib(id, "vertexPosition");
+    shader.locs[SHADER_LOC_VERTEX_TEXCOORD01] = rlGetLocationAttrib(id, "vertexTexCoord");
+    shader.locs[SHADER_LOC_VERTEX_TEXCOORD02] = rlGetLocationAttrib(id, "vertexTexCoord2");
+    shader.locs[SHADER_LOC_VERTEX_NORMAL]     = rlGetLocationAttrib(id, "vertexNormal");
+    shader.locs[SHADER_LOC_VERTEX_TANGENT]    = rlGetLocationAttrib(id, "vertexTangent");
+    shader.locs[SHADER_LOC_VERTEX_COLOR]      = rlGetLocationAttrib(id, "vertexColor");
+    shader.locs[SHADER_LOC_MATRIX_MVP]        = rlGetLocationUniform(id, "mvp");
+    shader.locs[SHADER_LOC_MATRIX_VIEW]       = rlGetLocationUniform(id, "matView");
+    shader.locs[SHADER_LOC_MATRIX_PROJECTION] = rlGetLocationUniform(id, "matProjection");
+    shader.locs[SHADER_LOC_MATRIX_MODEL]      = rlGetLocationUniform(id, "matModel");
+    shader.locs[SHADER_LOC_MATRIX_NORMAL]     = rlGetLocationUniform(id, "matNormal");
+    shader.locs[SHADER_LOC_COLOR_DIFFUSE]     = rlGetLocationUniform(id, "colDiffuse");
+    shader.locs[SHADER_LOC_MAP_DIFFUSE]       = rlGetLocationUniform(id, "texture0");
+    shader.locs[SHADER_LOC_MAP_SPECULAR]      = rlGetLocationUniform(id, "texture1");
+    shader.locs[SHADER_LOC_MAP_NORMAL]        = rlGetLocationUniform(id, "texture2");
+    return shader;
+}
+
+/*
+ *@Goal: program from the cached binary file
+ *@Note: return 0 if file is missing, stale or the driver reject it
+ */
+[[nodiscard]] [[maybe_unused]]
+auto loadProgramBinary(ShaderCache const & cache, str const & path, u64 const sourceHash)
+    -> u32
+{
+    if (!FileExists(path.c_str()))
+        return 0;
+    i32            fileSize {0};
+    unsigned char* data = LoadFileData(path.c_str(), &fileSize);
+    if (data == nullptr)
+        return 0;
+
+    u32          id {0};
+    BinaryHeader header {};
+    if (cast(std::size_t, fileSize) >= sizeof(BinaryHeader))
+        std::memcpy(&header, data, sizeof(BinaryHeader));
+    if (header.magic == binaryMagic && header.sourceHash == sourceHash &&
+        header.driverHash == cache.driverHash && header.size > 0 &&
+        cast(std::size_t, fileSize) == sizeof(BinaryHeader) + header.size)
+    {
+        id = cache.createProgram();
+        cache.programBinary(id,
+                            header.format,
+                            data + sizeof(BinaryHeader),
+                            cast(i32, header.size));
+        // driver can reject a valid looking binary (e.g. updated Mesa build)
+        i32 isLinked {0};
+        cache.getProgramiv(id, glLinkStatus, &isLinked);
+        if (isLinked == 0)
+        {
+            cache.deleteProgram(id);
+            id = 0;
+        }
+    }
+    UnloadFileData(data);
+    return id;
+}
+
+/*
+ *@Goal: write the linked program to the cache file
+ *@Note: driver can return an empty binary (nothing is written)
+ */
+[[maybe_unused]]
+auto saveProgramBinary(ShaderCache const & cache,
+                       str const &         path,
+                       u32 const           id,
+                       u64 const           sourceHash) -> void
+{
+    i32 size {0};
+    cache.getProgramiv(id, glProgramBinaryLength, &size);
+    if (size <= 0)
+        return;
+
+    std::vector<unsigned char> data(sizeof(BinaryHeader) + cast(std::size_t, size));
+    BinaryHeader header {.sourceHash = sourceHash, .driverHash = cache.driverHash};
+    i32          written {0};
+    cache.getProgramBinary(id, size, &written, &header.format, data.data() + sizeof(BinaryHeader));
+    if (written <= 0)
+        return;
+    header.size = cast(u32, written);
+    std::memcpy(data.data(), &header, sizeof(BinaryHeader));
+    (void)SaveFileData(path.c_str(),
+                       data.data(),
+                       cast(i32, sizeof(BinaryHeader) + header.size));
+}
+
+/*
+ *@Goal: LoadShader with the program binary cache
+ *@Note: empty vsFileName => default vertex shader
+ *@Note: compile error => default shader (same as LoadShader)
+ */
+[[nodiscard]] [[maybe_unused]]
+auto loadShader(ShaderCache & cache, str_v const vsFileName, str_v const fsFileName)
+    -> Shader
+{
+    PROFILE_SCOPE("load shader "s + str {fsFileName});
+    auto const loadText = [](str_v const fileName) -> char* {
+        return fileName.empty()
+                   ? nullptr
+                   : LoadFileText(
+                         RA_Global::pathToFile(fileName, RA_Global::EFileType::Shader)
+                             .c_str());
+    };
+    char* const vsCode = loadText(vsFileName);
+    char* const fsCode = loadText(fsFileName);
+    // glsl version is in the source => it is part of the hash
+    // missing file => raylib default shader (it can change with raylib version)
+    str_v const defaultCode {"raylib " RAYLIB_VERSION};
+    u64 const   sourceHash  = hashText(fsCode == nullptr ? defaultCode : str_v {fsCode},
+                                    hashText("|"sv,
+                                             hashText(vsCode == nullptr ? defaultCode
+                                                                        : str_v {vsCode})));
+    str const   path = cache.directory + str {cacheFilePrefix} +
+                     (vsFileName.empty() ? str {} : str {vsFileName} + '_') +
+                     str {fsFileName} + ".bin";
+
+    u32 const id = cache.isSupported ? loadProgramBinary(cache, path, sourceHash) : 0;
+    Shader    shader {};
+    if (id != 0)
+    {
+        shader = makeShader(id);
+        ++cache.hitCount;
+    }
+    else
+    {
+        shader = LoadShaderFromMemory(vsCode, fsCode);
+        if (cache.isSupported && shader.id != rlGetShaderIdDefault())
+            saveProgramBinary(cache, path, shader.id, sourceHash);
+        ++cache.missCount;
+    }
+    UnloadFileText(vsCode);
+    UnloadFileText(fsCode);
+    return shader;
+}
+
+}  // namespace RA_Shader
 namespace RA_Font
 {
 
@@ -71,8 +440,10 @@ namespace RA_Font
  * @Goat: draw text as a sdf mode
  */
 [[nodiscard]] [[maybe_unused]]
-auto initSDFFont(str_v const fontFileName, i32 const fontSize, i32 const glyphCount)
-    -> std::pair<Font, Shader>
+auto initSDFFont(RA_Shader::ShaderCache & shaderCache,
+                 str_v const              fontFileName,
+                 i32 const                fontSize,
+                 i32 const                glyphCount) -> std::pair<Font, Shader>
 {
 
     // Loading file to memory
@@ -97,10 +468,7 @@ auto initSDFFont(str_v const fontFileName, i32 const fontSize, i32 const glyphCo
     UnloadImage(atlas);
     UnloadFileData(fileData);  // Free memory from loaded file
     // Load SDF required shader (we use default vertex shader)
-    Shader const shader = LoadShader(nullptr,
-                                     RA_Global::pathToFile("sdf.fs"sv,
-                                                           RA_Global::EFileType::Shader)
-                                         .c_str());
+    Shader const shader = RA_Shader::loadShader(shaderCache, ""sv, "sdf.fs"sv);
     SetTextureFilter(fontSDF.texture,
                      TEXTURE_FILTER_BILINEAR);  // Required for SDF font
     return std::pair {fontSDF, shader};
@@ -461,6 +829,16 @@ public:
         return m_randDistro(rand32);
     }
 
+    /*
+     *@Goal: same random sequence on every run (input replay)
+     *@Warning: call it before other threads use GRandom
+     */
+    [[maybe_unused]]
+    static auto reseed(u32 const seed) noexcept -> void
+    {
+        rand32.seed(seed);
+    }
+
 private:
 
     [[nodiscard]] [[maybe_unused]]
@@ -480,1186 +858,4367 @@ private:
 };
 
 /*
- * @Goal: check an expresion in runtime if not android
- * @Note: pass a true condition that you need like percent>100 fail
+ *@Goal: fixed tick simulation clock (physics does not depend on render rate)
+ *@Note: frame time is clamped to maxSteps ticks => a slow frame does not cause
+ * more slow frames (spiral of death)
+ *@Note: alpha is where the render is between the previous and current tick
  */
-[[maybe_unused]]
-auto checkAtRuntime(bool faildCondition, str_v const errMsg) noexcept -> void
+class FixedClock
 {
-#ifdef DEBUG
-    if (myproject::cmake::platform != "Android"sv && faildCondition)
+public:
+
+    FixedClock() = delete;
+    explicit FixedClock(f32 const tickRate, u32 const maxSteps) noexcept :
+    m_tickSeconds {1.f / tickRate},
+    m_maxSteps {maxSteps}
     {
-        std::cerr << errMsg << '\n';
-        assert(!faildCondition);
     }
-#endif  // DEBUG
-}
-/*
- *@Note: the parent x and y (origin) should be top-left e.x:(0,0)
- *@Note: widthPercent  and heightPercent is calculated based on parent w,h
- *@Warning: the width and height of the parent should be less than window size
- */
-[[nodiscard]] [[maybe_unused]]
-auto placeRelativeCenter(Rectangle const & parentInfo,
-                         u8 const          widthPercent,
-                         u8 const          heightPercent) noexcept -> Rectangle
-{
 
-    // bounds checking on input args (debug only)
-    checkAtRuntime((widthPercent > 100 || heightPercent > 100 ||
-                    widthPercent == 0 || heightPercent == 0),
-                   "Placement Relative inputs should be 1<n<100 "
-                   "in percentage "
-                   "(unsigned int)\n"sv);
+    /*
+     *@Goal: add the frame time and return how many ticks should be simulated
+     */
+    [[nodiscard]] [[maybe_unused]]
+    auto advance(f32 const frameSeconds) noexcept -> u32
+    {
+        m_accumulator += std::clamp(frameSeconds,
+                                    0.f,
+                                    m_tickSeconds * cast(f32, m_maxSteps));
+        u32 steps {0};
+        while (m_accumulator >= m_tickSeconds && steps < m_maxSteps)
+        {
+            m_accumulator -= m_tickSeconds;
+            ++steps;
+        }
+        m_tickCount += steps;
+        return steps;
+    }
 
-    f32 const newX = parentInfo.x + (parentInfo.width / 2.f);
-    f32 const newY = parentInfo.y + (parentInfo.height / 2.f);
+    /*
+     *@Goal: count ticks that are stepped without the frame time (lock-step)
+     */
+    [[maybe_unused]]
+    auto advanceTicks(u32 const steps) noexcept -> void
+    {
+        m_tickCount += steps;
+    }
 
-    f32 const newW = parentInfo.width * widthPercent / 100.f;
-    f32 const newH = parentInfo.height * heightPercent / 100.f;
+    [[nodiscard]] [[maybe_unused]]
+    auto alpha() const noexcept -> f32
+    {
+        return std::min(m_accumulator / m_tickSeconds, 1.f);
+    }
 
-    return Rectangle {.x      = newX - (newW / 2.f),
-                      .y      = newY - (newH / 2.f),
-                      .width  = newW,
-                      .height = newH};
-}
-/*
- *@Goal: calculate position and size of object based on desired
- *percentage of parent cordinate note: x and y should be 0<n<100
- *@Note: widthPercent and heightPercent calculate based on
- *reminding space of parent width and height so if you say 100
- *it fill reminding space of width
- */
-[[nodiscard]] [[maybe_unused]]
-auto placeRelative(Rectangle const & parentInfo,
-                   u8 const          xPercentOffset,
-                   u8 const          yPercentOffset,
-                   u8 const          wPercentReminded,
-                   u8 const          hPercentReminded) noexcept -> Rectangle
-{
-    // width and height percent reminded checking
-    checkAtRuntime((wPercentReminded == 0 || hPercentReminded == 0),
-                   "width and height percent should not be zero"
-                   "in percentage "
-                   "(unsigned int)\n"sv);
+    [[nodiscard]] [[maybe_unused]]
+    auto tickSeconds() const noexcept -> f32
+    {
+        return m_tickSeconds;
+    }
 
-    // bounds checking on input args (debug only)
-    checkAtRuntime((xPercentOffset > 100 || yPercentOffset > 100 ||
-                    wPercentReminded > 100 || hPercentReminded > 100),
-                   "Placement Relative inputs should be for \n x,y= "
-                   "0<n<100 \nw,h= 1<n<100\n"
-                   "in percentage "
-                   "(unsigned int)\n"sv);
+    [[nodiscard]] [[maybe_unused]]
+    auto tickCount() const noexcept -> u64
+    {
+        return m_tickCount;
+    }
 
-    f32 const newX = cast(f32, parentInfo.x + parentInfo.width) *
-                     xPercentOffset / 100.f;
-    f32 const newY = cast(f32, parentInfo.y + parentInfo.height) *
-                     yPercentOffset / 100.f;
-    return Rectangle {.x     = newX,
-                      .y     = newY,
-                      .width = (cast(f32, parentInfo.width) - newX) *
-                               wPercentReminded / 100.f,
-                      .height = (cast(f32, parentInfo.height) - newY) *
-                                hPercentReminded / 100.f};
-}
+private:
 
-// grid index order row:3 column:3
-// 9 8 7
-// 6 5 4
-// 3 2 1
-struct GridInfo
-{
-    Rectangle rect;
-    Vector2   cellSize;
-    u16       columnCount;
-    u16       rowCount;
+    f32 m_tickSeconds;
+    f32 m_accumulator {0.f};
+    u32 m_maxSteps;
+    u64 m_tickCount {0};
 };
 
-/*
- *
- *@Goal: initilizer function for gridInfo object
- *@Note: col and row should be bigger than 2
- */
-[[nodiscard]] [[maybe_unused]]
-inline auto createGridInfo(Rectangle const & gridRect,
-                           u8 const          columnCount = 2,
-                           u8 const          rowCount = 2) noexcept -> GridInfo
+enum class FrameMode : u8
 {
-    // col and row should be bigger than 2X2
-    // bounds checking on input args (debug only)
-    checkAtRuntime((columnCount < 2 || rowCount < 2),
-                   "column and row should be bigger than 2\n"sv);
-    return GridInfo {.rect        = Rectangle {.x      = gridRect.x,
-                                               .y      = gridRect.y,
-                                               .width  = gridRect.width,
-                                               .height = gridRect.height},
-                     .cellSize    = Vector2 {gridRect.width / columnCount,
-                                          gridRect.height / rowCount},
-                     .columnCount = columnCount,
-                     .rowCount    = rowCount};
-}
+    Uncapped = 0,
+    Target,
+    Idle
+};
+
 /*
- *@Goal: draw grid on screen in real time with grid info
- *@Note: it can be slow if its a static grid use genGridTexture
+ *@Goal: pacing of the main loop (call endFrame right after EndDrawing)
+ *@Note: Uncapped => no wait, Target => sleep then spin till the frame end
+ * (sleep is not accurate => the last spinSeconds is a busy wait)
+ *@Note: Idle => target rate while something animates, otherwise block on
+ * input and redraw only when the idle timer is due
+ *@Note: cpu time is of the process (all threads) over the whole frame with
+ * the wait => it is what each mode cost
  */
-[[maybe_unused]]
-auto drawGrid(GridInfo const & grid, Color const lineColor = WHITE) noexcept -> void
+class FrameScheduler
 {
-    // draw in between lines based on col and row
-    // drawing row lines
-    f32 yOffset {grid.rect.y};
-    for (u16 i {}; i <= grid.rowCount; ++i)
+public:
+
+    FrameScheduler() = delete;
+    explicit FrameScheduler(FrameMode const mode,
+                            f64 const       targetRate,
+                            f64 const       idleRate) noexcept :
+    m_targetSeconds {1.0 / targetRate},
+    m_idleSeconds {1.0 / idleRate},
+    m_frameStart {wallNow()},
+    m_cpuStart {cpuNow()},
+    m_mode {mode}
     {
-        DrawLineV(Vector2 {grid.rect.x, yOffset},
-                  Vector2 {grid.rect.width + grid.rect.x, yOffset},
-                  lineColor);
-        yOffset += grid.cellSize.y;
     }
-    // drawing column lines
-    f32 xOffset {grid.rect.x};
-    for (u16 i {}; i <= grid.columnCount; ++i)
+
+    /*
+     *@Goal: wait for the next frame based on the mode
+     *@Note: onWait is called between the input polls of the idle wait (e.g.
+     * audio stream update)
+     *@Warning: idle wait poll the input => call it after EndDrawing
+     */
+    template <typename WaitFn>
+    auto endFrame(bool const isAnimating, WaitFn && onWait) -> void
     {
-        DrawLineV(Vector2 {xOffset, grid.rect.y},
-                  Vector2 {xOffset, grid.rect.height + grid.rect.y},
-                  lineColor);
-        xOffset += grid.cellSize.x;
+        m_workSeconds = wallNow() - m_frameStart;
+        switch (m_mode)
+        {
+            case FrameMode::Uncapped:
+                break;
+            case FrameMode::Target:
+            {
+                waitUntil(m_frameStart + m_targetSeconds);
+                break;
+            }
+            case FrameMode::Idle:
+            {
+                if (isAnimating)
+                {
+                    waitUntil(m_frameStart + m_targetSeconds);
+                    break;
+                }
+                f64 const deadline = m_frameStart + m_idleSeconds;
+                while (!hasInputEvent())
+                {
+                    f64 const remaining = deadline - wallNow();
+                    if (remaining <= 0.0)
+                        break;
+                    // one poll per target frame => input latency is one frame
+                    std::this_thread::sleep_for(
+                        std::chrono::duration<f64> {std::min(remaining, m_targetSeconds)});
+                    PollInputEvents();
+                    onWait();
+                }
+                break;
+            }
+        }
+        f64 const cpu = cpuNow();
+        m_cpuSeconds  = cpu - m_cpuStart;
+        m_cpuStart    = cpu;
+        m_frameStart  = wallNow();
+        PROFILE_COUNTER("frame cpu ms", m_cpuSeconds * 1000.0);
     }
-}
 
-/*
-* @Goal: crete a grid texture
-* @Note: its more performance friendly for static grid
-* @Note: if you want opeque picture zero out the alpha on backgroundColor
-* @Note: Alpha is btw 0 and 255
- TODO: make it lazy load
-*/
-[[nodiscard]] [[maybe_unused]]
-auto genGridTexture(GridInfo const & grid,
-                    f32 const        resulationScale = 1.f,
-                    f32 const        lineThickness   = 10.f,
-                    Color const      lineColor       = WHITE,
-                    Color const backgroundColor = BLACK) noexcept -> Texture2D
-{
-    Image img = GenImageColor(cast(i32, grid.rect.width * resulationScale),
-                              cast(i32, grid.rect.height * resulationScale),
-                              backgroundColor);
-    // draw in between lines based on col and row
-    // drawing row lines
-    f64 yOffset {cast(f64, lineThickness) * 0.5 * resulationScale};
-    for (u16 i {}; i <= grid.rowCount; ++i)
+    /*
+     *@Goal: the next frame start now (e.g. right before the loop => setup
+     * time is not in the first frame)
+     */
+    [[maybe_unused]]
+    auto restart() noexcept -> void
     {
-        Vector2 const v0 {0.f, cast(f32, yOffset)};
-        Vector2 const v1 {grid.rect.width * resulationScale, cast(f32, yOffset)};
-        if (i != 0 && i != grid.rowCount)
-            ImageDrawLineEx(&img,
-                            v0,
-                            v1,
-                            cast(i32, lineThickness * resulationScale),
-                            lineColor);
-        yOffset += cast(f64,
-                        (grid.cellSize.y - (lineThickness * 0.5f)) * resulationScale);
+        m_frameStart = wallNow();
+        m_cpuStart   = cpuNow();
     }
-    // draw column lines
-    f64 xOffset {cast(f64, lineThickness) * 0.5 * resulationScale};
-    for (u16 i {}; i <= grid.columnCount; ++i)
+
+    [[maybe_unused]]
+    auto nextMode() noexcept -> void
     {
-        Vector2 const v0 {cast(f32, xOffset), 0.f};
-        Vector2 const v1 {cast(f32, xOffset), grid.rect.height * resulationScale};
-        if (i != 0 && i != grid.rowCount)
-            ImageDrawLineEx(&img,
-                            v0,
-                            v1,
-                            cast(i32, lineThickness * resulationScale),
-                            lineColor);
-        xOffset += cast(f64,
-                        (grid.cellSize.x - (lineThickness * 0.5f)) * resulationScale);
+        m_mode = cast(FrameMode, (cast(u8, m_mode) + 1) % 3);
     }
-    Texture2D gridTexture = LoadTextureFromImage(img);
-    // #if defined(DEBUG)
-    // ExportImage(img, "myGrid.png");
-    // #endif
-    UnloadImage(img);
-    return gridTexture;
-}
 
-/*
- * @Goat: return the grid-cell(Rectangle) based on input point if is inside the grid
- */
-[[nodiscard]] [[maybe_unused]]
-auto point2RectOnGrid(Vector2 const & point, GridInfo const & grid) noexcept
-    -> std::optional<Rectangle>
-{
-    // sanity check
-    checkAtRuntime((grid.cellSize.x == 0.f || grid.cellSize.y == 0.f ||
-                    grid.columnCount == 0 || grid.rowCount == 0),
-                   "grid cell size or Row/Col count should not be zero"sv);
-    checkAtRuntime((point.x < 0.f || point.y < 0.f),
-                   "point should not have negative value"sv);
+    [[nodiscard]] [[maybe_unused]]
+    auto mode() const noexcept -> FrameMode
+    {
+        return m_mode;
+    }
 
-    // does this point is inside the grid
-    if (point.x < grid.rect.x || (point.x - grid.rect.x) > grid.rect.width ||
-        point.y < grid.rect.y || (point.y - grid.rect.y) > grid.rect.height)
-        return std::nullopt;
+    [[nodiscard]] [[maybe_unused]]
+    auto modeName() const noexcept -> char const*
+    {
+        constexpr std::array<char const*, 3> const names {"uncapped", "target", "idle"};
+        return names[cast(u8, m_mode)];
+    }
 
-    auto const tempReminderX = cast(u8, (point.x - grid.rect.x) / grid.cellSize.x);
-    auto x1 = cast(u16, (tempReminderX * grid.cellSize.x) + grid.rect.x);
+    // process cpu time of the last frame (with the wait)
+    [[nodiscard]] [[maybe_unused]]
+    auto cpuSeconds() const noexcept -> f64
+    {
+        return m_cpuSeconds;
+    }
 
-    if (tempReminderX == 0)
-        x1 = cast(u16, grid.rect.x);
-    else if (tempReminderX >= grid.columnCount)
-        x1 = cast(u16, ((grid.columnCount - 1) * grid.cellSize.x) + grid.rect.x);
+    // wall time of the last frame without the wait (for frame budgets)
+    [[nodiscard]] [[maybe_unused]]
+    auto workSeconds() const noexcept -> f32
+    {
+        return cast(f32, m_workSeconds);
+    }
 
-    auto const tempReminderY = cast(u8, (point.y - grid.rect.y) / grid.cellSize.y);
-    auto y1 = cast(u16, (tempReminderY * grid.cellSize.y) + grid.rect.y);
-    if (tempReminderY == 0)
-        y1 = cast(u16, grid.rect.y);
-    else if (tempReminderY >= grid.rowCount)
-        y1 = cast(u16, ((grid.rowCount - 1) * grid.cellSize.y) + grid.rect.y);
-    return Rectangle {cast(f32, x1),
-                      cast(f32, y1),
-                      grid.cellSize.x,
-                      grid.cellSize.y};
-}
+private:
+
+    [[nodiscard]]
+    static auto wallNow() noexcept -> f64
+    {
+        return std::chrono::duration<f64> {
+            std::chrono::steady_clock::now().time_since_epoch()}
+            .count();
+    }
+
+    [[nodiscard]]
+    static auto cpuNow() noexcept -> f64
+    {
+#if defined(CLOCK_PROCESS_CPUTIME_ID)
+        timespec time {};
+        clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &time);
+        return cast(f64, time.tv_sec) + (cast(f64, time.tv_nsec) * 1e-9);
+#else  // msvc clock() is wall time => cpu time is an upper bound there
+        return cast(f64, std::clock()) / CLOCKS_PER_SEC;
+#endif
+    }
+
+    /*
+     *@Note: just the keys the loop handle (IsKeyPressed does not pop the key
+     * queue like GetKeyPressed)
+     */
+    [[nodiscard]]
+    static auto hasInputEvent() noexcept -> bool
+    {
+        return IsMouseButtonPressed(MOUSE_BUTTON_LEFT) ||
+               IsMouseButtonPressed(MOUSE_BUTTON_RIGHT) || IsKeyPressed(KEY_ESCAPE) ||
+               IsKeyPressed(KEY_F) || IsKeyPressed(KEY_BACK) || GetTouchPointCount() > 0 ||
+               IsWindowResized() || WindowShouldClose();
+    }
+
+    auto waitUntil(f64 const deadline) const noexcept -> void
+    {
+        f64 const sleepEnd = deadline - m_spinSeconds;
+        if (f64 const now = wallNow(); now < sleepEnd)
+            std::this_thread::sleep_for(std::chrono::duration<f64> {sleepEnd - now});
+        while (wallNow() < deadline)
+        {
+            // spin the rest (sleep can oversleep by a scheduler tick)
+        }
+    }
+
+    f64       m_targetSeconds;
+    f64       m_idleSeconds;
+    f64       m_spinSeconds {.002};
+    f64       m_frameStart;
+    f64       m_cpuStart;
+    f64       m_cpuSeconds {0.0};
+    f64       m_workSeconds {0.0};
+    FrameMode m_mode;
+};
 
 /*
- * @Goat: return the index of grid cell based on the input point
- * @Warning:index should be checked by caller and should not be ZERO
+ *@Goal: summary of the frame times of a run (milliseconds)
  */
+struct FrameStats
+{
+    f64 meanMs {0.0};
+    f64 minMs {0.0};
+    f64 p50Ms {0.0};
+    f64 p95Ms {0.0};
+    f64 p99Ms {0.0};
+    f64 maxMs {0.0};
+};
+
 [[nodiscard]] [[maybe_unused]]
-auto point2IndexOnGrid(Vector2 const & point, GridInfo const & grid) noexcept -> u16
+auto makeFrameStats(std::span<f32 const> const frameSeconds) -> FrameStats
 {
-    // sanity check
-    checkAtRuntime((grid.cellSize.x == 0.f || grid.cellSize.y == 0.f ||
-                    grid.columnCount == 0 || grid.rowCount == 0),
-                   "grid cell size or Row/Col count should not be zero"sv);
-    checkAtRuntime((point.x < 0.f || point.y < 0.f),
-                   "input point should not have negative value"sv);
+    if (frameSeconds.empty())
+        return FrameStats {};
+    std::vector<f32> sorted(frameSeconds.begin(), frameSeconds.end());
+    std::ranges::sort(sorted);
+    auto const percentile = [&sorted](f64 const p) -> f64 {
+        auto const index = cast(std::size_t, p * cast(f64, sorted.size() - 1));
+        return cast(f64, sorted[index]) * 1000.0;
+    };
+    f64 sum {0.0};
+    for (f32 const seconds : sorted)
+        sum += cast(f64, seconds);
+    return FrameStats {.meanMs = sum * 1000.0 / cast(f64, sorted.size()),
+                       .minMs  = cast(f64, sorted.front()) * 1000.0,
+                       .p50Ms  = percentile(.5),
+                       .p95Ms  = percentile(.95),
+                       .p99Ms  = percentile(.99),
+                       .maxMs  = cast(f64, sorted.back()) * 1000.0};
+}
 
-    // does this point is inside the grid
-    if (point.x < grid.rect.x || (point.x - grid.rect.x) > grid.rect.width ||
-        point.y < grid.rect.y || (point.y - grid.rect.y) > grid.rect.height)
-        return 0;
+/*
+ *@Goal: input of one loop tick (what the input stage of the loop use)
+ */
+struct TickInput
+{
+    std::optional<Vector2> click {};
+    bool                   isQuit {false};
+    bool                   isBack {false};  // android back button
+    bool                   isNextFrameMode {false};
+};
 
-    auto const tempReminderX = cast(u16, (point.x - grid.rect.x) / grid.cellSize.x);
-    auto const tempReminderY = cast(u16, (point.y - grid.rect.y) / grid.cellSize.y);
-    u16 const totalLength {cast(u16, grid.columnCount * grid.rowCount)};
+enum class InputMode : u8
+{
+    Live = 0,
+    Record,
+    Replay
+};
 
-    return cast(u16,
-                (totalLength -
-                 ((tempReminderX) + (tempReminderY * grid.columnCount))));
-}
+enum class InputType : u16
+{
+    Click = 0,
+    Quit,
+    Back,
+    NextFrameMode,
+    End  // last tick of the recording => replay quit here
+};
+
+// file layout (native endian): InputFileHeader | InputEvent[eventCount]
+inline constexpr u32 inputFileMagic   = 0x4E495852;  // "RXIN"
+inline constexpr u16 inputFileVersion = 2;  // 2: tick is the simulation tick
+
+struct InputFileHeader
+{
+    u32 magic {inputFileMagic};
+    u16 version {inputFileVersion};
+    u16 reserved {};
+    u32 seed {};  // GRandom seed of the recorded run
+    u32 eventCount {};
+};
+static_assert(sizeof(InputFileHeader) == 16);
+
+// just the ticks that had input are stored (click is in whole pixels)
+// tick is the simulation tick the input is applied before
+struct InputEvent
+{
+    u32       tick {};
+    InputType type {};
+    i16       x {};
+    i16       y {};
+    u16       reserved {};
+};
+static_assert(sizeof(InputEvent) == 12);
 
 /*
- * @Goat: return the top-left corner point of the Rectangle(grid cell) inside
- * the grid based on input index(the output Point cordinate start from zero)
- * @Warning: index does start from 1 and should not be Zero
- * // TODO: this function just work with static col/row number 3*3
+ *@Goal: input stage of the loop from the device, device + recording to a
+ * file, or a recorded file (same ticks => same game on every replay)
+ *@Note: events are keyed by the simulation tick, record/replay run the
+ * simulation in lock-step (fixed ticks per loop iteration, see
+ * SimConfig::lockStepTicks) and reseed GRandom => its random effects
+ * (bodies, confetti) are the same too
+ *@Warning: start record/replay before other threads use GRandom
  */
-[[nodiscard]] [[maybe_unused]]
-auto index2PointOnGrid(u16 const index, GridInfo const & grid) noexcept -> Vector2
+class InputSource
 {
-    checkAtRuntime((index == 0), "index should start from ONE not Zero"sv);
-    checkAtRuntime((index > (grid.columnCount * grid.rowCount)),
-                   "index is not correct e.g:(1 to row*col)"sv);
+public:
 
-    i32        ix              = 0;
-    auto const inBetweenCountX = grid.columnCount - 2;
-    u16 const  offsetX         = ((grid.columnCount * grid.rowCount) - index) %
-                        grid.columnCount;
-    auto const endX           = grid.columnCount - 1;
-    u8         tempInBetweenX = (offsetX < inBetweenCountX)
-                                    ? cast(u8, inBetweenCountX - offsetX)
-                                    : 0;
-    for (u16 i = 0; i < grid.columnCount; i++)
+    InputSource() = default;
+    ~InputSource() = default;
+
+    // Deleted members
+    InputSource(InputSource const &)             = delete;
+    InputSource & operator=(InputSource const &) = delete;
+    InputSource(InputSource &&)                  = delete;
+    InputSource & operator=(InputSource &&)      = delete;
+
+    /*
+     *@Goal: record the device input, the file is written by finish()
+     */
+    [[maybe_unused]]
+    auto startRecord(str_v const path) -> void
     {
-        if (offsetX == 0)  // start
-        {
-            ix = 0;
-            break;
-        }
-        if (offsetX == endX)  // end
-            ix = endX;
-        else if (i < (endX) && i > 0 && (tempInBetweenX < inBetweenCountX))  // middle
+        m_mode = InputMode::Record;
+        m_path = path;
+        m_seed = std::random_device {}();
+        m_events.clear();
+        GRandom::reseed(m_seed);
+    }
+
+    /*
+     *@Goal: load a recorded file
+     *@Note: return false if file is missing or corrupted (input stay live)
+     */
+    [[nodiscard]] [[maybe_unused]]
+    auto startReplay(str_v const path) -> bool
+    {
+        str const filePath {path};
+        if (!FileExists(filePath.c_str()))
+            return false;
+        i32            fileSize {0};
+        unsigned char* data = LoadFileData(filePath.c_str(), &fileSize);
+        if (data == nullptr)
+            return false;
+
+        InputFileHeader header {};
+        if (cast(std::size_t, fileSize) >= sizeof(InputFileHeader))
+            std::memcpy(&header, data, sizeof(InputFileHeader));
+        bool const isValid = header.magic == inputFileMagic &&
+                             header.version == inputFileVersion &&
+                             cast(std::size_t, fileSize) ==
+                                 sizeof(InputFileHeader) +
+                                     (header.eventCount * sizeof(InputEvent));
+        if (isValid)
         {
-            ix++;
-            tempInBetweenX++;
+            m_events.resize(header.eventCount);
+            std::memcpy(m_events.data(),
+                        data + sizeof(InputFileHeader),
+                        m_events.size() * sizeof(InputEvent));
+            m_mode = InputMode::Replay;
+            m_seed = header.seed;
+            GRandom::reseed(m_seed);
         }
+        UnloadFileData(data);
+        return isValid;
     }
 
-    i32        iy              = 0;
-    auto const inBetweenCountY = grid.rowCount - 2;
-    u16 const offsetY = ((grid.columnCount * grid.rowCount) - index) / grid.rowCount;
-    u8         tempInBetweenY = (offsetY < inBetweenCountY)
-                                    ? cast(u8, inBetweenCountY - offsetY)
-                                    : 0;
-    auto const endY           = grid.rowCount - 1;
-    for (u16 i = 0; i < grid.rowCount; i++)
+    /*
+     *@Goal: input of this loop iteration (call it once per iteration)
+     *@Note: tick is the simulation tick (lock-step) => ignored if live
+     *@Note: replay still poll the quit key (abort the replay)
+     */
+    [[nodiscard]] [[maybe_unused]]
+    auto poll(u64 const tick) -> TickInput
     {
-        if (offsetY == (0))  // start
+        m_tick = cast(u32, tick);
+        TickInput input {};
+        if (m_mode == InputMode::Replay)
         {
-            iy = 0;
-            break;
+            for (; m_next < m_events.size() && m_events[m_next].tick <= m_tick; ++m_next)
+                applyEvent(m_events[m_next], input);
+            input.isQuit = input.isQuit || IsKeyPressed(KEY_ESCAPE);
         }
-        if (offsetY == (endY))  // end
-            iy = endY;
-        else if (i < (endY) && i > 0 && (tempInBetweenY < inBetweenCountY))  // middle
+        else
         {
-            iy++;
-            tempInBetweenY++;
+            input = pollDevice();
+            if (m_mode == InputMode::Record)
+                recordTick(input);
         }
+        return input;
     }
-    i32 const x = cast(i32, grid.rect.x + (cast(f32, ix) * grid.cellSize.x));
-    i32 const y = cast(i32, grid.rect.y + (cast(f32, iy) * grid.cellSize.y));
-    return {cast(f32, x), cast(f32, y)};
-}
 
-/*
- * @Goat: return the center of the Rectangle(grid cell) inside the grid based on input index
- * @Warning: index does start from 1 and should not be Zero
- */
-[[nodiscard]] [[maybe_unused]]
-auto index2CenterPointOnGrid(u16 const index, GridInfo const & grid) noexcept
-    -> Vector2
-{
-    auto temp = index2PointOnGrid(index, grid);
+    /*
+     *@Goal: write the recording (end tick is this tick)
+     *@Note: return false if it could not be written
+     */
+    [[nodiscard]] [[maybe_unused]]
+    auto finish() -> bool
+    {
+        if (m_mode != InputMode::Record)
+            return true;
+        m_events.push_back(InputEvent {.tick = m_tick, .type = InputType::End});
+        InputFileHeader const header {.seed       = m_seed,
+                                      .eventCount = cast(u32, m_events.size())};
+        std::vector<unsigned char> data(sizeof(InputFileHeader) +
+                                        (m_events.size() * sizeof(InputEvent)));
+        std::memcpy(data.data(), &header, sizeof(InputFileHeader));
+        std::memcpy(data.data() + sizeof(InputFileHeader),
+                    m_events.data(),
+                    m_events.size() * sizeof(InputEvent));
+        m_mode = InputMode::Live;
+        return SaveFileData(m_path.c_str(), data.data(), cast(i32, data.size()));
+    }
+
+    [[nodiscard]] [[maybe_unused]]
+    auto mode() const noexcept -> InputMode
+    {
+        return m_mode;
+    }
+
+private:
+
+    // same priority as the old input stage (one kind of input per tick)
+    [[nodiscard]]
+    static auto pollDevice() noexcept -> TickInput
+    {
+        TickInput input {};
+        if (IsMouseButtonPressed(MOUSE_LEFT_BUTTON))
+            input.click = GetTouchPosition(0);
+        else if (IsKeyPressed(KEY_ESCAPE))
+            input.isQuit = true;
+        else if (IsKeyPressed(KEY_F))
+            input.isNextFrameMode = true;
+        else if (IsKeyPressed(KEY_BACK))
+            input.isBack = true;
+        return input;
+    }
+
+    /*
+     *@Note: click is rounded like it is stored => live run == its replay
+     */
+    auto recordTick(TickInput & input) -> void
+    {
+        auto const push = [this](InputType const type, i16 const x, i16 const y) {
+            m_events.push_back(InputEvent {.tick = m_tick, .type = type, .x = x, .y = y});
+        };
+        if (input.click.has_value())
+        {
+            auto const x = cast(i16, std::lround(input.click->x));
+            auto const y = cast(i16, std::lround(input.click->y));
+            input.click  = Vector2 {cast(f32, x), cast(f32, y)};
+            push(InputType::Click, x, y);
+        }
+        if (input.isQuit)
+            push(InputType::Quit, 0, 0);
+        if (input.isBack)
+            push(InputType::Back, 0, 0);
+        if (input.isNextFrameMode)
+            push(InputType::NextFrameMode, 0, 0);
+    }
+
+    static auto applyEvent(InputEvent const & event, TickInput & input) noexcept -> void
+    {
+        switch (event.type)
+        {
+            case InputType::Click:
+            {
+                input.click = Vector2 {cast(f32, event.x), cast(f32, event.y)};
+                break;
+            }
+            case InputType::Quit:
+                [[fallthrough]];
+            case InputType::End:
+            {
+                input.isQuit = true;
+                break;
+            }
+            case InputType::Back:
+            {
+                input.isBack = true;
+                break;
+            }
+            case InputType::NextFrameMode:
+            {
+                input.isNextFrameMode = true;
+                break;
+            }
+        }
+    }
+
+    std::vector<InputEvent> m_events {};
+    str                     m_path {};
+    std::size_t             m_next {0};  // next event of the replay
+    u32                     m_tick {0};  // simulation tick of the last poll
+    u32                     m_seed {0};
+    InputMode               m_mode {InputMode::Live};
+};
+
+/*
+ *@Goal: work-stealing job system (the thread that submit jobs is worker 0)
+ *@Note: each worker own a queue, pop from the back of its own queue and steal
+ * from the front of the others when it is empty
+ *@Note: JobFn has the same shape as box2d task callback
+ *@Warning: wait() should be called by the thread that submit the jobs
+ */
+class JobSystem
+{
+public:
+
+    using JobFn = void (*)(i32 begin, i32 end, u32 workerIndex, void* context);
+
+    // jobs that should finish together (e.g: one box2d task)
+    struct TaskGroup
+    {
+        std::atomic<u32> pending {0};
+    };
+
+    JobSystem() = delete;
+    explicit JobSystem(u32 const workerCount) :
+    m_queues(std::max(workerCount, 1U))
+    {
+        for (u32 i = 1; i < m_queues.size(); ++i)
+            m_threads.emplace_back([this, i]() { workerLoop(i); });
+    }
+
+    ~JobSystem()
+    {
+        {
+            std::lock_guard<std::mutex> const lock(m_sleepLock);
+            m_isRunning = false;
+        }
+        m_wakeUp.notify_all();
+        for (auto & thread : m_threads)
+            thread.join();
+    }
+
+    // Deleted members
+    JobSystem(JobSystem const &)             = delete;
+    JobSystem & operator=(JobSystem const &) = delete;
+    JobSystem(JobSystem &&)                  = delete;
+    JobSystem & operator=(JobSystem &&)      = delete;
+
+    [[nodiscard]] [[maybe_unused]]
+    auto workerCount() const noexcept -> u32
+    {
+        return cast(u32, m_queues.size());
+    }
+
+    /*
+     *@Goal: split [0, itemCount) in ranges (at least minRange items) as jobs
+     *@Note: ranges are spread over all the queues so workers start without
+     * stealing
+     */
+    [[maybe_unused]]
+    auto parallelFor(JobFn const fn,
+                     i32 const   itemCount,
+                     i32 const   minRange,
+                     void* const context,
+                     TaskGroup & group) -> void
+    {
+        if (itemCount <= 0)
+            return;
+        i32 const jobCount = std::clamp(itemCount / std::max(minRange, 1),
+                                        1,
+                                        cast(i32, workerCount()));
+        i32 const rangeSize = itemCount / jobCount;
+        group.pending.fetch_add(cast(u32, jobCount), std::memory_order_relaxed);
+        for (i32 job = 0; job < jobCount; ++job)
+        {
+            i32 const begin = job * rangeSize;
+            i32 const end   = (job == jobCount - 1) ? itemCount : begin + rangeSize;
+            WorkQueue & queue = m_queues[cast(std::size_t, job) % m_queues.size()];
+            {
+                std::lock_guard<std::mutex> const lock(queue.lock);
+                queue.jobs.push_back(Job {fn, begin, end, context, &group});
+            }
+        }
+        m_queuedCount.fetch_add(cast(u32, jobCount), std::memory_order_release);
+        // sleeping workers check the count under this lock => no lost wake up
+        {
+            std::lock_guard<std::mutex> const lock(m_sleepLock);
+        }
+        m_wakeUp.notify_all();
+    }
+
+    /*
+     *@Goal: help running jobs (as worker 0) till all jobs of the group finish
+     */
+    [[maybe_unused]]
+    auto wait(TaskGroup const & group) -> void
+    {
+        while (group.pending.load(std::memory_order_acquire) != 0)
+        {
+            if (!runOneJob(0))
+                std::this_thread::yield();
+        }
+    }
+
+private:
+
+    struct Job
+    {
+        JobFn      fn;
+        i32        begin;
+        i32        end;
+        void*      context;
+        TaskGroup* group;
+    };
+
+    // own cache line => workers dont fight over the locks of other queues
+    struct alignas(64) WorkQueue
+    {
+        std::mutex      lock;
+        std::deque<Job> jobs;
+    };
+
+    [[nodiscard]]
+    auto popJob(u32 const workerIndex, Job & outJob) -> bool
+    {
+        // own queue (newest job is hot in cache)
+        {
+            WorkQueue &                 queue = m_queues[workerIndex];
+            std::lock_guard<std::mutex> const lock(queue.lock);
+            if (!queue.jobs.empty())
+            {
+                outJob = queue.jobs.back();
+                queue.jobs.pop_back();
+                return true;
+            }
+        }
+        // steal the oldest job of the others
+        for (u32 i = 1; i < m_queues.size(); ++i)
+        {
+            WorkQueue & queue = m_queues[(workerIndex + i) % m_queues.size()];
+            std::lock_guard<std::mutex> const lock(queue.lock);
+            if (!queue.jobs.empty())
+            {
+                outJob = queue.jobs.front();
+                queue.jobs.pop_front();
+                return true;
+            }
+        }
+        return false;
+    }
+
+    auto runOneJob(u32 const workerIndex) -> bool
+    {
+        Job job {};
+        if (!popJob(workerIndex, job))
+            return false;
+        m_queuedCount.fetch_sub(1, std::memory_order_relaxed);
+        job.fn(job.begin, job.end, workerIndex, job.context);
+        job.group->pending.fetch_sub(1, std::memory_order_release);
+        return true;
+    }
+
+    auto workerLoop(u32 const workerIndex) -> void
+    {
+        while (true)
+        {
+            if (runOneJob(workerIndex))
+                continue;
+            std::unique_lock<std::mutex> lock(m_sleepLock);
+            m_wakeUp.wait(lock,
+                          [this]()
+                          {
+                              return !m_isRunning ||
+                                     m_queuedCount.load(std::memory_order_acquire) != 0;
+                          });
+            if (!m_isRunning)
+                return;
+        }
+    }
+
+    std::vector<WorkQueue>   m_queues;
+    std::vector<std::thread> m_threads;
+    std::atomic<u32>         m_queuedCount {0};
+    std::mutex               m_sleepLock;
+    std::condition_variable  m_wakeUp;
+    bool                     m_isRunning {true};
+};
+
+/*
+ *@Goal: uniform grid spatial hash of points (particles, ui elements, ...)
+ *@Note: build is a counting sort (count -> prefix sum -> scatter) => items of a
+ * cell are contiguous and there is no allocation after the first build
+ *@Note: points outside the area go to one extra bucket that is always tested
+ *@Note: for rects (ui hit test) insert the centers and pad the query with half
+ * of the biggest rect
+ */
+class SpatialGrid
+{
+public:
+
+    SpatialGrid() = delete;
+    explicit SpatialGrid(Rectangle const & area, f32 const cellSize) :
+    m_area {area},
+    m_invCellSize {1.f / cellSize},
+    m_columnCount {std::max(cast(u32, std::ceil(area.width / cellSize)), 1U)},
+    m_rowCount {std::max(cast(u32, std::ceil(area.height / cellSize)), 1U)},
+    m_cellStart((m_columnCount * m_rowCount) + 2, 0)  // + outside bucket + end
+    {
+    }
+
+    /*
+     *@Goal: rebuild the grid from itemCount points (position(i) -> Vector2)
+     */
+    template <typename PositionFn>
+    auto build(u32 const itemCount, PositionFn && position) -> void
+    {
+        PROFILE();
+        std::ranges::fill(m_cellStart, 0);
+        m_itemCell.resize(itemCount);
+        m_unsortedPoints.resize(itemCount);
+        m_items.resize(itemCount);
+        m_points.resize(itemCount);
+        // count
+        for (u32 i = 0; i < itemCount; ++i)
+        {
+            Vector2 const point = position(i);
+            u32 const     cell  = cellOf(point);
+            m_unsortedPoints[i] = point;
+            m_itemCell[i]       = cell;
+            ++m_cellStart[cell + 1];
+        }
+        // prefix sum => index of the first item of each cell
+        for (std::size_t cell = 1; cell < m_cellStart.size(); ++cell)
+            m_cellStart[cell] += m_cellStart[cell - 1];
+        // scatter
+        m_cursor.assign(m_cellStart.begin(), m_cellStart.end() - 1);
+        for (u32 i = 0; i < itemCount; ++i)
+        {
+            u32 const slot = m_cursor[m_itemCell[i]]++;
+            m_items[slot]  = i;
+            m_points[slot] = m_unsortedPoints[i];
+        }
+    }
+
+    /*
+     *@Goal: call fn(items, points, isInside) for every cell that overlap rect
+     *@Note: isInside => the whole cell is in the rect (no need to test items)
+     *@Note: the outside bucket is always visited with isInside = false
+     */
+    template <typename CellFn>
+    auto forEachCell(Rectangle const & rect, CellFn && fn) const -> void
+    {
+        // rect in cell units
+        f32 const left    = (rect.x - m_area.x) * m_invCellSize;
+        f32 const top     = (rect.y - m_area.y) * m_invCellSize;
+        f32 const right   = (rect.x + rect.width - m_area.x) * m_invCellSize;
+        f32 const bottom  = (rect.y + rect.height - m_area.y) * m_invCellSize;
+        f32 const columns = cast(f32, m_columnCount);
+        f32 const rows    = cast(f32, m_rowCount);
+        if (right >= 0.f && bottom >= 0.f && left < columns && top < rows)
+        {
+            u32 const firstX = cast(u32, std::max(left, 0.f));
+            u32 const firstY = cast(u32, std::max(top, 0.f));
+            u32 const lastX  = cast(u32, std::min(right, columns - 1.f));
+            u32 const lastY  = cast(u32, std::min(bottom, rows - 1.f));
+            for (u32 y = firstY; y <= lastY; ++y)
+            {
+                bool const isRowInside = cast(f32, y) >= top && cast(f32, y + 1) <= bottom;
+                for (u32 x = firstX; x <= lastX; ++x)
+                {
+                    bool const isInside = isRowInside && cast(f32, x) >= left &&
+                                          cast(f32, x + 1) <= right;
+                    visitCell((y * m_columnCount) + x, isInside, fn);
+                }
+            }
+        }
+        visitCell(outsideCell(), false, fn);
+    }
+
+    /*
+     *@Goal: call fn(index) for every item inside the rect
+     */
+    template <typename ItemFn>
+    auto queryRect(Rectangle const & rect, ItemFn && fn) const -> void
+    {
+        forEachCell(rect,
+                    [&](std::span<u32 const> const     items,
+                        std::span<Vector2 const> const points,
+                        bool const                     isInside)
+                    {
+                        for (std::size_t i = 0; i < items.size(); ++i)
+                        {
+                            if (isInside || CheckCollisionPointRec(points[i], rect))
+                                fn(items[i]);
+                        }
+                    });
+    }
+
+    /*
+     *@Goal: call fn(index) for every item in the radius of the point
+     */
+    template <typename ItemFn>
+    auto queryRadius(Vector2 const & point, f32 const radius, ItemFn && fn) const
+        -> void
+    {
+        Rectangle const bound {.x      = point.x - radius,
+                               .y      = point.y - radius,
+                               .width  = radius * 2.f,
+                               .height = radius * 2.f};
+        f32 const       radiusSqr = radius * radius;
+        forEachCell(bound,
+                    [&](std::span<u32 const> const     items,
+                        std::span<Vector2 const> const points,
+                        bool)
+                    {
+                        for (std::size_t i = 0; i < items.size(); ++i)
+                        {
+                            f32 const dx = points[i].x - point.x;
+                            f32 const dy = points[i].y - point.y;
+                            if (((dx * dx) + (dy * dy)) <= radiusSqr)
+                                fn(items[i]);
+                        }
+                    });
+    }
+
+    [[nodiscard]] [[maybe_unused]]
+    auto itemCount() const noexcept -> u32
+    {
+        return cast(u32, m_items.size());
+    }
+
+private:
+
+    [[nodiscard]]
+    auto outsideCell() const noexcept -> u32
+    {
+        return m_columnCount * m_rowCount;
+    }
+
+    [[nodiscard]]
+    auto cellOf(Vector2 const & point) const noexcept -> u32
+    {
+        f32 const x = (point.x - m_area.x) * m_invCellSize;
+        f32 const y = (point.y - m_area.y) * m_invCellSize;
+        // written this way so NaN goes to the outside bucket too
+        if (!(x >= 0.f && y >= 0.f && x < cast(f32, m_columnCount) &&
+              y < cast(f32, m_rowCount)))
+            return outsideCell();
+        return (cast(u32, y) * m_columnCount) + cast(u32, x);
+    }
+
+    template <typename CellFn>
+    auto visitCell(u32 const cell, bool const isInside, CellFn & fn) const -> void
+    {
+        u32 const first = m_cellStart[cell];
+        u32 const count = m_cellStart[cell + 1] - first;
+        if (count != 0)
+        {
+            fn(std::span<u32 const> {m_items}.subspan(first, count),
+               std::span<Vector2 const> {m_points}.subspan(first, count),
+               isInside);
+        }
+    }
+
+    Rectangle            m_area;
+    f32                  m_invCellSize;
+    u32                  m_columnCount;
+    u32                  m_rowCount;
+    std::vector<u32>     m_cellStart;  // first item of each cell (+ end)
+    std::vector<u32>     m_cursor;
+    std::vector<u32>     m_itemCell;
+    std::vector<Vector2> m_unsortedPoints;
+    std::vector<u32>     m_items;   // item indexes sorted by cell
+    std::vector<Vector2> m_points;  // positions sorted by cell
+};
+
+/*
+ *@Goal: lock-free triple buffer (one writer thread, one reader thread)
+ *@Note: writer fill writeBuffer() then publish(), reader acquire() the newest
+ * published buffer (if there is one) and read readBuffer() till next acquire
+ *@Note: writer never wait for reader and reader never see a half written buffer
+ */
+template <typename T>
+class TripleBuffer
+{
+public:
+
+    TripleBuffer() = delete;
+    explicit TripleBuffer(T const & initial) :
+    m_buffers {initial, initial, initial}
+    {
+    }
+
+    // Deleted members
+    TripleBuffer(TripleBuffer const &)             = delete;
+    TripleBuffer & operator=(TripleBuffer const &) = delete;
+    TripleBuffer(TripleBuffer &&)                  = delete;
+    TripleBuffer & operator=(TripleBuffer &&)      = delete;
+
+    [[nodiscard]] [[maybe_unused]]
+    auto writeBuffer() noexcept -> T &
+    {
+        return m_buffers[m_writeIndex];
+    }
+
+    /*
+     *@Goal: swap the written buffer with the middle one (writer side)
+     */
+    [[maybe_unused]]
+    auto publish() noexcept -> void
+    {
+        u8 const old = m_middle.exchange(cast(u8, m_writeIndex | freshBit),
+                                         std::memory_order_acq_rel);
+        m_writeIndex = cast(u8, old & indexMask);
+    }
+
+    /*
+     *@Goal: take the newest published buffer (reader side)
+     *@Note: return false if nothing is published after the last acquire
+     */
+    [[maybe_unused]]
+    auto acquire() noexcept -> bool
+    {
+        if ((m_middle.load(std::memory_order_relaxed) & freshBit) == 0)
+            return false;
+        u8 const old = m_middle.exchange(m_readIndex, std::memory_order_acq_rel);
+        m_readIndex  = cast(u8, old & indexMask);
+        return true;
+    }
+
+    [[nodiscard]] [[maybe_unused]]
+    auto readBuffer() const noexcept -> T const &
+    {
+        return m_buffers[m_readIndex];
+    }
+
+private:
+
+    static constexpr u8 indexMask {0x3};
+    static constexpr u8 freshBit {0x4};  // middle buffer is not read yet
+
+    std::array<T, 3> m_buffers;
+    // own cache line => writer and reader dont share the indexes
+    alignas(64) std::atomic<u8> m_middle {1};
+    alignas(64) u8 m_writeIndex {0};
+    alignas(64) u8 m_readIndex {2};
+};
+
+/*
+ * @Goal: check an expresion in runtime if not android
+ * @Note: pass a true condition that you need like percent>100 fail
+ */
+[[maybe_unused]]
+auto checkAtRuntime(bool faildCondition, str_v const errMsg) noexcept -> void
+{
+#ifdef DEBUG
+    if (myproject::cmake::platform != "Android"sv && faildCondition)
+    {
+        std::cerr << errMsg << '\n';
+        assert(!faildCondition);
+    }
+#endif  // DEBUG
+}
+/*
+ *@Note: the parent x and y (origin) should be top-left e.x:(0,0)
+ *@Note: widthPercent  and heightPercent is calculated based on parent w,h
+ *@Warning: the width and height of the parent should be less than window size
+ */
+[[nodiscard]] [[maybe_unused]]
+auto placeRelativeCenter(Rectangle const & parentInfo,
+                         u8 const          widthPercent,
+                         u8 const          heightPercent) noexcept -> Rectangle
+{
+
+    // bounds checking on input args (debug only)
+    checkAtRuntime((widthPercent > 100 || heightPercent > 100 ||
+                    widthPercent == 0 || heightPercent == 0),
+                   "Placement Relative inputs should be 1<n<100 "
+                   "in percentage "
+                   "(unsigned int)\n"sv);
+
+    f32 const newX = parentInfo.x + (parentInfo.width / 2.f);
+    f32 const newY = parentInfo.y + (parentInfo.height / 2.f);
+
+    f32 const newW = parentInfo.width * widthPercent / 100.f;
+    f32 const newH = parentInfo.height * heightPercent / 100.f;
+
+    return Rectangle {.x      = newX - (newW / 2.f),
+                      .y      = newY - (newH / 2.f),
+                      .width  = newW,
+                      .height = newH};
+}
+/*
+ *@Goal: calculate position and size of object based on desired
+ *percentage of parent cordinate note: x and y should be 0<n<100
+ *@Note: widthPercent and heightPercent calculate based on
+ *reminding space of parent width and height so if you say 100
+ *it fill reminding space of width
+ */
+[[nodiscard]] [[maybe_unused]]
+auto placeRelative(Rectangle const & parentInfo,
+                   u8 const          xPercentOffset,
+                   u8 const          yPercentOffset,
+                   u8 const          wPercentReminded,
+                   u8 const          hPercentReminded) noexcept -> Rectangle
+{
+    // width and height percent reminded checking
+    checkAtRuntime((wPercentReminded == 0 || hPercentReminded == 0),
+                   "width and height percent should not be zero"
+                   "in percentage "
+                   "(unsigned int)\n"sv);
+
+    // bounds checking on input args (debug only)
+    checkAtRuntime((xPercentOffset > 100 || yPercentOffset > 100 ||
+                    wPercentReminded > 100 || hPercentReminded > 100),
+                   "Placement Relative inputs should be for \n x,y= "
+                   "0<n<100 \nw,h= 1<n<100\n"
+                   "in percentage "
+                   "(unsigned int)\n"sv);
+
+    f32 const newX = cast(f32, parentInfo.x + parentInfo.width) *
+                     xPercentOffset / 100.f;
+    f32 const newY = cast(f32, parentInfo.y + parentInfo.height) *
+                     yPercentOffset / 100.f;
+    return Rectangle {.x     = newX,
+                      .y     = newY,
+                      .width = (cast(f32, parentInfo.width) - newX) *
+                               wPercentReminded / 100.f,
+                      .height = (cast(f32, parentInfo.height) - newY) *
+                                hPercentReminded / 100.f};
+}
+
+// grid index order row:3 column:3
+// 9 8 7
+// 6 5 4
+// 3 2 1
+struct GridInfo
+{
+    Rectangle rect;
+    Vector2   cellSize;
+    u16       columnCount;
+    u16       rowCount;
+};
+
+/*
+ *
+ *@Goal: initilizer function for gridInfo object
+ *@Note: col and row should be bigger than 2
+ */
+[[nodiscard]] [[maybe_unused]]
+inline auto createGridInfo(Rectangle const & gridRect,
+                           u8 const          columnCount = 2,
+                           u8 const          rowCount = 2) noexcept -> GridInfo
+{
+    // col and row should be bigger than 2X2
+    // bounds checking on input args (debug only)
+    checkAtRuntime((columnCount < 2 || rowCount < 2),
+                   "column and row should be bigger than 2\n"sv);
+    return GridInfo {.rect        = Rectangle {.x      = gridRect.x,
+                                               .y      = gridRect.y,
+                                               .width  = gridRect.width,
+                                               .height = gridRect.height},
+                     .cellSize    = Vector2 {gridRect.width / columnCount,
+                                          gridRect.height / rowCount},
+                     .columnCount = columnCount,
+                     .rowCount    = rowCount};
+}
+/*
+ *@Goal: draw grid on screen in real time with grid info
+ *@Note: it can be slow if its a static grid use genGridTexture
+ */
+[[maybe_unused]]
+auto drawGrid(GridInfo const & grid, Color const lineColor = WHITE) noexcept -> void
+{
+    // draw in between lines based on col and row
+    // drawing row lines
+    f32 yOffset {grid.rect.y};
+    for (u16 i {}; i <= grid.rowCount; ++i)
+    {
+        DrawLineV(Vector2 {grid.rect.x, yOffset},
+                  Vector2 {grid.rect.width + grid.rect.x, yOffset},
+                  lineColor);
+        yOffset += grid.cellSize.y;
+    }
+    // drawing column lines
+    f32 xOffset {grid.rect.x};
+    for (u16 i {}; i <= grid.columnCount; ++i)
+    {
+        DrawLineV(Vector2 {xOffset, grid.rect.y},
+                  Vector2 {xOffset, grid.rect.height + grid.rect.y},
+                  lineColor);
+        xOffset += grid.cellSize.x;
+    }
+}
+
+/*
+* @Goal: crete a grid texture
+* @Note: its more performance friendly for static grid
+* @Note: if you want opeque picture zero out the alpha on backgroundColor
+* @Note: Alpha is btw 0 and 255
+* @Note: fallback of RA_Render::GridRenderer (loaded on its first draw)
+*/
+[[nodiscard]] [[maybe_unused]]
+auto genGridTexture(GridInfo const & grid,
+                    f32 const        resulationScale = 1.f,
+                    f32 const        lineThickness   = 10.f,
+                    Color const      lineColor       = WHITE,
+                    Color const backgroundColor = BLACK) noexcept -> Texture2D
+{
+    Image img = GenImageColor(cast(i32, grid.rect.width * resulationScale),
+                              cast(i32, grid.rect.height * resulationScale),
+                              backgroundColor);
+    // draw in between lines based on col and row
+    // drawing row lines
+    f64 yOffset {cast(f64, lineThickness) * 0.5 * resulationScale};
+    for (u16 i {}; i <= grid.rowCount; ++i)
+    {
+        Vector2 const v0 {0.f, cast(f32, yOffset)};
+        Vector2 const v1 {grid.rect.width * resulationScale, cast(f32, yOffset)};
+        if (i != 0 && i != grid.rowCount)
+            ImageDrawLineEx(&img,
+                            v0,
+                            v1,
+                            cast(i32, lineThickness * resulationScale),
+                            lineColor);
+        yOffset += cast(f64,
+                        (grid.cellSize.y - (lineThickness * 0.5f)) * resulationScale);
+    }
+    // draw column lines
+    f64 xOffset {cast(f64, lineThickness) * 0.5 * resulationScale};
+    for (u16 i {}; i <= grid.columnCount; ++i)
+    {
+        Vector2 const v0 {cast(f32, xOffset), 0.f};
+        Vector2 const v1 {cast(f32, xOffset), grid.rect.height * resulationScale};
+        if (i != 0 && i != grid.rowCount)
+            ImageDrawLineEx(&img,
+                            v0,
+                            v1,
+                            cast(i32, lineThickness * resulationScale),
+                            lineColor);
+        xOffset += cast(f64,
+                        (grid.cellSize.x - (lineThickness * 0.5f)) * resulationScale);
+    }
+    Texture2D gridTexture = LoadTextureFromImage(img);
+    // #if defined(DEBUG)
+    // ExportImage(img, "myGrid.png");
+    // #endif
+    UnloadImage(img);
+    return gridTexture;
+}
+
+/*
+ * @Goat: return the grid-cell(Rectangle) based on input point if is inside the grid
+ */
+[[nodiscard]] [[maybe_unused]]
+auto point2RectOnGrid(Vector2 const & point, GridInfo const & grid) noexcept
+    -> std::optional<Rectangle>
+{
+    // sanity check
+    checkAtRuntime((grid.cellSize.x == 0.f || grid.cellSize.y == 0.f ||
+                    grid.columnCount == 0 || grid.rowCount == 0),
+                   "grid cell size or Row/Col count should not be zero"sv);
+    checkAtRuntime((point.x < 0.f || point.y < 0.f),
+                   "point should not have negative value"sv);
+
+    // does this point is inside the grid
+    if (point.x < grid.rect.x || (point.x - grid.rect.x) > grid.rect.width ||
+        point.y < grid.rect.y || (point.y - grid.rect.y) > grid.rect.height)
+        return std::nullopt;
+
+    auto const tempReminderX = cast(u8, (point.x - grid.rect.x) / grid.cellSize.x);
+    auto x1 = cast(u16, (tempReminderX * grid.cellSize.x) + grid.rect.x);
+
+    if (tempReminderX == 0)
+        x1 = cast(u16, grid.rect.x);
+    else if (tempReminderX >= grid.columnCount)
+        x1 = cast(u16, ((grid.columnCount - 1) * grid.cellSize.x) + grid.rect.x);
+
+    auto const tempReminderY = cast(u8, (point.y - grid.rect.y) / grid.cellSize.y);
+    auto y1 = cast(u16, (tempReminderY * grid.cellSize.y) + grid.rect.y);
+    if (tempReminderY == 0)
+        y1 = cast(u16, grid.rect.y);
+    else if (tempReminderY >= grid.rowCount)
+        y1 = cast(u16, ((grid.rowCount - 1) * grid.cellSize.y) + grid.rect.y);
+    return Rectangle {cast(f32, x1),
+                      cast(f32, y1),
+                      grid.cellSize.x,
+                      grid.cellSize.y};
+}
+
+/*
+ * @Goat: return the index of grid cell based on the input point
+ * @Warning:index should be checked by caller and should not be ZERO
+ */
+[[nodiscard]] [[maybe_unused]]
+auto point2IndexOnGrid(Vector2 const & point, GridInfo const & grid) noexcept -> u16
+{
+    // sanity check
+    checkAtRuntime((grid.cellSize.x == 0.f || grid.cellSize.y == 0.f ||
+                    grid.columnCount == 0 || grid.rowCount == 0),
+                   "grid cell size or Row/Col count should not be zero"sv);
+    checkAtRuntime((point.x < 0.f || point.y < 0.f),
+                   "input point should not have negative value"sv);
+
+    // does this point is inside the grid
+    if (point.x < grid.rect.x || (point.x - grid.rect.x) > grid.rect.width ||
+        point.y < grid.rect.y || (point.y - grid.rect.y) > grid.rect.height)
+        return 0;
+
+    auto const tempReminderX = cast(u16, (point.x - grid.rect.x) / grid.cellSize.x);
+    auto const tempReminderY = cast(u16, (point.y - grid.rect.y) / grid.cellSize.y);
+    u16 const totalLength {cast(u16, grid.columnCount * grid.rowCount)};
+
+    return cast(u16,
+                (totalLength -
+                 ((tempReminderX) + (tempReminderY * grid.columnCount))));
+}
+
+/*
+ * @Goal: cell id under the input point (single hit test for a click)
+ * @Note: cell id is 0-based row-major from top-left (same as RA_Game::Board)
+ * @Note: nullopt if the point is outside of the grid
+ */
+[[nodiscard]] [[maybe_unused]]
+auto point2CellOnGrid(Vector2 const & point, GridInfo const & grid) noexcept
+    -> std::optional<u16>
+{
+    // sanity check
+    checkAtRuntime((grid.cellSize.x == 0.f || grid.cellSize.y == 0.f ||
+                    grid.columnCount == 0 || grid.rowCount == 0),
+                   "grid cell size or Row/Col count should not be zero"sv);
+
+    // does this point is inside the grid
+    if (point.x < grid.rect.x || (point.x - grid.rect.x) > grid.rect.width ||
+        point.y < grid.rect.y || (point.y - grid.rect.y) > grid.rect.height)
+        return std::nullopt;
+
+    // point on the right/bottom edge belong to the last column/row
+    auto const x = std::min(cast(u16, (point.x - grid.rect.x) / grid.cellSize.x),
+                            cast(u16, grid.columnCount - 1));
+    auto const y = std::min(cast(u16, (point.y - grid.rect.y) / grid.cellSize.y),
+                            cast(u16, grid.rowCount - 1));
+    return cast(u16, x + (y * grid.columnCount));
+}
+
+/*
+ * @Goal: the Rectangle(grid cell) of the cell id (see point2CellOnGrid)
+ * @Note: top-left is snapped to whole pixels like point2RectOnGrid
+ */
+[[nodiscard]] [[maybe_unused]]
+auto cell2RectOnGrid(u16 const cell, GridInfo const & grid) noexcept -> Rectangle
+{
+    checkAtRuntime((cell >= (grid.columnCount * grid.rowCount)),
+                   "cell is not correct e.g:(0 to row*col - 1)"sv);
+    auto const x = cast(u16, cell % grid.columnCount);
+    auto const y = cast(u16, cell / grid.columnCount);
+    return Rectangle {
+        .x      = cast(f32, cast(u16, (x * grid.cellSize.x) + grid.rect.x)),
+        .y      = cast(f32, cast(u16, (y * grid.cellSize.y) + grid.rect.y)),
+        .width  = grid.cellSize.x,
+        .height = grid.cellSize.y};
+}
+
+/*
+ * @Goat: return the top-left corner point of the Rectangle(grid cell) inside
+ * the grid based on input index(the output Point cordinate start from zero)
+ * @Warning: index does start from 1 and should not be Zero
+ * // TODO: this function just work with static col/row number 3*3
+ */
+[[nodiscard]] [[maybe_unused]]
+auto index2PointOnGrid(u16 const index, GridInfo const & grid) noexcept -> Vector2
+{
+    checkAtRuntime((index == 0), "index should start from ONE not Zero"sv);
+    checkAtRuntime((index > (grid.columnCount * grid.rowCount)),
+                   "index is not correct e.g:(1 to row*col)"sv);
+
+    i32        ix              = 0;
+    auto const inBetweenCountX = grid.columnCount - 2;
+    u16 const  offsetX         = ((grid.columnCount * grid.rowCount) - index) %
+                        grid.columnCount;
+    auto const endX           = grid.columnCount - 1;
+    u8         tempInBetweenX = (offsetX < inBetweenCountX)
+                                    ? cast(u8, inBetweenCountX - offsetX)
+                                    : 0;
+    for (u16 i = 0; i < grid.columnCount; i++)
+    {
+        if (offsetX == 0)  // start
+        {
+            ix = 0;
+            break;
+        }
+        if (offsetX == endX)  // end
+            ix = endX;
+        else if (i < (endX) && i > 0 && (tempInBetweenX < inBetweenCountX))  // middle
+        {
+            ix++;
+            tempInBetweenX++;
+        }
+    }
+
+    i32        iy              = 0;
+    auto const inBetweenCountY = grid.rowCount - 2;
+    u16 const offsetY = ((grid.columnCount * grid.rowCount) - index) / grid.rowCount;
+    u8         tempInBetweenY = (offsetY < inBetweenCountY)
+                                    ? cast(u8, inBetweenCountY - offsetY)
+                                    : 0;
+    auto const endY           = grid.rowCount - 1;
+    for (u16 i = 0; i < grid.rowCount; i++)
+    {
+        if (offsetY == (0))  // start
+        {
+            iy = 0;
+            break;
+        }
+        if (offsetY == (endY))  // end
+            iy = endY;
+        else if (i < (endY) && i > 0 && (tempInBetweenY < inBetweenCountY))  // middle
+        {
+            iy++;
+            tempInBetweenY++;
+        }
+    }
+    i32 const x = cast(i32, grid.rect.x + (cast(f32, ix) * grid.cellSize.x));
+    i32 const y = cast(i32, grid.rect.y + (cast(f32, iy) * grid.cellSize.y));
+    return {cast(f32, x), cast(f32, y)};
+}
+
+/*
+ * @Goat: return the center of the Rectangle(grid cell) inside the grid based on input index
+ * @Warning: index does start from 1 and should not be Zero
+ */
+[[nodiscard]] [[maybe_unused]]
+auto index2CenterPointOnGrid(u16 const index, GridInfo const & grid) noexcept
+    -> Vector2
+{
+    auto temp = index2PointOnGrid(index, grid);
     return Vector2 {temp.x + (grid.cellSize.x / 2.f),
                     temp.y + (grid.cellSize.y / 2.f)};
 }
 
 /*
- * @Goat: return the Rectangle(grid cell) inside the grid based on input index
- * @Warning: index does start from 1 and should not be Zero
+ * @Goat: return the Rectangle(grid cell) inside the grid based on input index
+ * @Warning: index does start from 1 and should not be Zero
+ */
+[[nodiscard]] [[maybe_unused]]
+auto index2RectOnGrid(u16 const index, GridInfo const & grid) noexcept -> Rectangle
+{
+    auto const point = index2PointOnGrid(index, grid);
+    return Rectangle {.x      = point.x,
+                      .y      = point.y,
+                      .width  = grid.cellSize.x,
+                      .height = grid.cellSize.y
+
+    };
+}
+
+/*
+ *@Goal: move a point(p1) towards the p2 based on some rate(pixelPerFrame)
+ */
+[[maybe_unused]]
+auto moveTowards(Vector2 & p1, Vector2 const & p2, u16 const pixelPerFrame) noexcept
+    -> void
+{
+    f32 const dx     = p2.x - p1.x;
+    f32 const dy     = p2.y - p1.y;
+    f32 const length = std::sqrt((dx * dx) + (dy * dy));
+
+    if (length > 0.f && (pixelPerFrame * GetFrameTime()) < length)
+    {  // Avoid overshooting
+        p1.x += (dx / length) * pixelPerFrame * GetFrameTime();
+        p1.y += (dy / length) * pixelPerFrame * GetFrameTime();
+    }
+    else
+        p1 = p2;  // Snap to target if within step size
+}
+
+/*
+ *@Goal: draw a rectangle like a line
+ */
+[[maybe_unused]]
+auto drawGoodLine(Vector2 const & start,
+                  Vector2 const & end,
+                  u16 const       lineThickness,
+                  Color const &   color) noexcept -> void
+{
+    f32 const rotation      = Vector2LineAngle(start, end) * -RAD2DEG;
+    f32 const currentLength = Vector2Length(start - end);
+    f32 const currentHeight = lineThickness;
+    f32       currentX      = 0.f;
+    f32       currentY      = 0.f;
+    u16 const tempRotation  = cast(u16, rotation);
+    // for angle that bigger than 135
+    if (tempRotation >= 135)
+    {
+        currentX = start.x;
+        currentY = start.y + (currentHeight * .5f);
+    }
+    // for 90 deg angle
+    else if (tempRotation == 90)
+    {
+        currentX = start.x + (currentHeight * .5f);
+        currentY = start.y;
+    }
+    // for grater than 40 deg
+    else if (tempRotation >= 40)
+    {
+        currentX = start.x;
+        currentY = start.y;
+    }
+    else  // its for 0 deg
+    {
+        currentX = start.x;
+        currentY = start.y - (currentHeight * .5f);
+    }
+    DrawRectanglePro({.x      = currentX,
+                      .y      = currentY,
+                      .width  = currentLength,
+                      .height = currentHeight},
+                     {},
+                     rotation,
+                     color);
+}
+/*
+ *@Goal: true if the point is out of the boundry (all 4 sides)
+ */
+auto isClippingForRender(Vector2 const & pos, Rectangle const & boundry) noexcept
+    -> bool
+{
+    // Demorgan law
+    return (pos.x < boundry.x || pos.y < boundry.y ||
+            pos.x > (boundry.x + boundry.width) || pos.y > (boundry.y + boundry.height));
+}
+}  // namespace RA_Util
+
+namespace RA_Anim
+{
+
+// RA_Render::pushAnim draw it in order of layer and depth
+struct AnimData
+{
+    Texture2D textureAnim;
+    Rectangle rect;
+    i32       counter;
+    i32       currentFrame;
+    i32       currentSpeed;
+    i32 const length;  // actual length is length -1
+    i32 const defaultSpeed;
+    i32 const speedMAX;
+    i32 const speedMIN;
+};
+
+[[nodiscard]] [[maybe_unused]]
+auto initAnim(str_v const fileName,
+              i32 const   animLenght,
+              i32 const   speed,
+              i32 const   speedMax) -> AnimData
+{
+    // str path;
+    // path.reserve(RA_Global::texturePath.size() + fileName.size());
+    // path.append(RA_Global::texturePath);
+    // path.append(fileName);
+    str const path {RA_Global::pathToFile(fileName, RA_Global::EFileType::Texture)};
+
+    if (FileExists(path.c_str()))
+    {
+        Texture2D const temp = LoadTexture(path.c_str());
+        return AnimData {.textureAnim  = temp,
+                         .rect         = {.x      = 0,
+                                          .y      = 0,
+                                          .width  = cast(f32, temp.width / animLenght),
+                                          .height = cast(f32, temp.height)},
+                         .counter      = 0,
+                         .currentFrame = 0,
+                         .currentSpeed = speed,
+                         .length       = animLenght,
+                         .defaultSpeed = speed,
+                         .speedMAX     = speedMax,
+                         .speedMIN     = 1};
+    }
+    std::cerr << "Error: " << fileName << " not found\n";
+    std::terminate();
+}
+[[maybe_unused]]
+auto cleanAnim(AnimData & outData) noexcept -> void
+{
+    UnloadTexture(outData.textureAnim);
+    outData.rect = Rectangle {0, 0, 0, 0};
+}
+
+/*
+ *@Goal: animation speed currection
+ *@Note: it works as a input output param refrence
+ *@Warning: internall function usage
+ */
+[[maybe_unused]]
+auto limitSpeedAnim(AnimData & outData) noexcept -> void
+{
+    if (outData.currentSpeed > outData.speedMAX)
+        outData.currentSpeed = outData.speedMAX;
+    else if (outData.currentSpeed < outData.speedMIN)
+        outData.currentSpeed = outData.speedMIN;
+}
+
+/*
+ *@Note: it works as a input output param refrence
+ */
+[[maybe_unused]]
+inline auto increaseAnimSpeed(AnimData & outData) noexcept -> void
+{
+    outData.currentSpeed += 1;
+    limitSpeedAnim(outData);
+}
+/*
+ *@Note: it works as a input output param refrence
+ */
+[[maybe_unused]]
+inline auto decreaseAnimSpeed(AnimData & outData) noexcept -> void
+{
+    outData.currentSpeed -= 1;
+    limitSpeedAnim(outData);
+}
+
+/*
+ * @Note: it works as a input output param refrence
+ */
+[[maybe_unused]]
+inline auto resetAnimSpeed(AnimData & outData) noexcept -> void
+{
+    outData.currentSpeed = outData.defaultSpeed;
+}
+/*
+ * @Note: it works as a input output param refrence
+ * @Warning: internall function usage for updateAnim
+ */
+[[maybe_unused]]
+inline auto resetAnim(AnimData & outData) noexcept -> void
+{
+    outData.currentFrame = 0;
+}
+// draw now (code order), RA_Render::pushAnim for the sorted draw
+[[maybe_unused]]
+auto renderAnim(AnimData const & data,
+                Vector2 const &  pos,
+                Color const      tint = WHITE) noexcept -> void
+{
+    DrawTextureRec(data.textureAnim, data.rect, pos, tint);
+}
+
+/*
+ *@Goal: get ready animation info for render them in gameloop
+ */
+[[maybe_unused]]
+auto updateAnim(AnimData & data) noexcept -> void
+{
+    data.counter++;
+    if (data.counter >= RA_Global::animationFPS / data.currentSpeed)
+    {
+        data.counter = 0;
+        // speed currection
+        limitSpeedAnim(data);
+        data.currentFrame++;
+
+        if (data.currentFrame > (data.length - 1))  // start animation frame is zero
+            resetAnim(data);
+
+        data.rect.x = cast(f32, data.currentFrame) *
+                      cast(f32, data.textureAnim.width) / cast(f32, data.length);
+    }
+}
+
+template <std::size_t size>
+[[maybe_unused]]
+auto defineCircles(RA_Util::GridInfo const &    gridInfo,
+                   std::array<u8, size> const & indexesCausesWin)
+    -> std::array<Vector2, size>
+{
+    std::array<Vector2, size> circles {};
+    for (size_t i = 0; i < indexesCausesWin.size(); ++i)
+    {
+        circles[i] = RA_Util::index2CenterPointOnGrid(indexesCausesWin[i], gridInfo);
+    }
+    return circles;
+}
+
+/*
+ *@Goal: next frame of the circles animation
+ *@Note: return how many circles are shown in this frame (at most circleCount)
+ */
+[[nodiscard]] [[maybe_unused]]
+auto updateAnimCircles(u32 const         currentFrame,
+                       u32 &             inFrameLimit,
+                       u8 &              inAnimState,
+                       u32 const         resetFrame,
+                       u32 const         jumpFrame,
+                       u16 const         jumpState,
+                       std::size_t const circleCount) noexcept -> std::size_t
+{
+    if (circleCount == 0)
+        return 0;
+    if (currentFrame == inFrameLimit)
+    {
+        inFrameLimit += jumpFrame;
+        inAnimState += jumpState;
+    }
+    if (inFrameLimit > resetFrame)
+        inFrameLimit = jumpFrame;
+    return std::min(cast(std::size_t, inAnimState), circleCount);
+}
+
+template <std::size_t size>
+[[maybe_unused]]
+auto drawAnimCircles(u32 const                         currentFrame,
+                     u32 &                             inFrameLimit,
+                     u8 &                              inAnimState,
+                     u32 const                         resetFrame,
+                     u32 const                         jumpFrame,
+                     u16 const                         jumpState,
+                     std::array<Vector2, size> const & circles,
+                     Color const                       color) -> void
+{
+    std::size_t const shownCount = updateAnimCircles(currentFrame,
+                                                     inFrameLimit,
+                                                     inAnimState,
+                                                     resetFrame,
+                                                     jumpFrame,
+                                                     jumpState,
+                                                     circles.size());
+    for (std::size_t i = 0; i < shownCount; ++i)
+        DrawCircle(cast(i32, circles[i].x), cast(i32, circles[i].y), 25.f, color);
+}
+
+
+}  // namespace RA_Anim
+namespace RA_UI
+{
+
+// entt that show as a ui element
+struct UIEntity
+{
+    enum Type
+    {
+        PlaceHolder,   // empty layout with chileds?
+        spalshScreen,  // layout with image and childes?
+        Lable,
+        Button,
+        RoundButton,
+        ProgressBar
+    };
+    // default initilize to -1 => invalid index
+    i32 id {-1};
+    i32 parent {-1};
+    i32 child {-1};
+    // event dispatch
+    bool canClick {false};
+    i32  onClickID {-1};     // clickable
+    i32  onHoverInID {-1};   // everything
+    i32  onHoverOutID {-1};  // everything
+    i32  onStart {-1};       // progressBar
+    i32  onCompleted {-1};   // progressBar
+    // layout
+    Rectangle layoutRect {};
+    Color     backgroundColor {RED};
+    f32       rotation {};
+    bool      layoutHidden {false};
+    // text lable
+    i64       textID {-1};
+    Rectangle txtRect {};
+    f32       txtRotation {};
+    Color     txtColor {BLUE};
+    i32       fontID {-1};
+    f32       fontSize {};
+    f32       fontSpacing {};
+    bool      txtHidden {false};
+    // Round Btn
+    f32   borderRoundness {};
+    f32   lineThickness {};
+    Color borderColor {WHITE};
+    bool  btnHidden {false};
+    // icon
+    i32       imageID {-1};
+    Rectangle imgRect {};
+    f32       imgRotation {};
+    Color     imgColor {GREEN};
+    bool      imgHidden {false};
+    // sound fx
+    i32 sfxID {-1};
+    // shader
+    i32   shaderID {-1};
+    Color shaderColor {WHITE};
+};
+
+struct UILable
+{
+    Vector2 position;
+    Color   textColor;
+
+    // *index of this item in owner array
+    // *index start from 0
+    // *(index < 0) means not init
+    u32 const fontIndx;
+    // lable allways has a text
+    // an indexid to hash table
+    u64 const textIndx;
+
+    f32     fontSize;
+    f32     fontSpacing;
+    Vector2 textSize;
+    // Shader shader;
+
+    // private:
+
+    // *index of this item in owner array
+    // *index start from 0
+    // *(index < 0) means not init
+    std::size_t const id;
+    // *index of this item in owner array
+    // *index start from 0
+    // *(index < 0) means not init
+    i32 const parentInxd;
+    bool      isHidden {false};
+};
+
+struct UIRouondLayout
+{
+    Rectangle rect;
+    f32       borderRoundness;
+    f32       lineThickness;
+    Color     borderColor;
+
+
+    // private:
+    // *index of this item in owner array
+    // *index start from 0
+    // *(index < 0) means not init
+    std::size_t const id;
+    bool              isHidden {false};
+};
+
+struct UIButton
+{
+    // *index of this item in owner array
+    // *index start from 0
+    // *(index < 0) means not init
+    std::size_t const id;
+    i32 const         layoutIndx;
+    i32 const         lableIndx;
+    // i32 const iconIndx;
+    bool isHidden {false};
+    // sound
+    // shader
+};
+
+// TODO: Optimization
+// TODO: use struct of array and optimize lable and btn based on static or changable
+// TODO: render once on texture and use it for draw on thefront of all elemnts
+std::vector<UIRouondLayout> layoutArray {};
+std::vector<str>            lablesTextArray {};
+std::vector<UILable>        lablesArray {};
+// std::vector<UIicon>         iconsArray;
+std::vector<UIButton> buttonsArray {};
+std::vector<Font>     fontsArray {};
+#define REQUIREDELEMENTS 10
+
+auto initUI() -> void
+{
+    layoutArray.reserve(REQUIREDELEMENTS);
+    lablesTextArray.reserve(REQUIREDELEMENTS);
+    lablesArray.reserve(REQUIREDELEMENTS);
+    buttonsArray.reserve(REQUIREDELEMENTS);
+    fontsArray.reserve(REQUIREDELEMENTS);
+}
+auto cleanUI() -> bool
+{
+    // if (layoutArray.empty() || lablesTextArray.empty() || lablesArray.empty() ||
+    //     buttonsArray.empty() || fontsArray.empty())
+    //     return false;
+    layoutArray.clear();
+    lablesTextArray.clear();
+    lablesArray.clear();
+    buttonsArray.clear();
+    fontsArray.clear();
+}
+
+auto getFontID(Font const & font) -> u32
+{
+    static u32 fontID {0};
+    fontsArray.emplace_back(font);
+    return fontID++;
+}
+
+auto initRoundButton(i32 const  layoutIndx,
+                     i32 const  lableIndx /*, i32 const iconIndx */,
+                     bool const isHidden = false) -> u32
+{
+    UIButton const btn {.id         = buttonsArray.size(),
+                        .layoutIndx = layoutIndx,
+                        .lableIndx  = lableIndx,
+                        .isHidden   = isHidden};
+    // TODO: add icon
+    //  .iconIndx   = iconIndx};
+    buttonsArray.emplace_back(btn);
+    return btn.id;
+}
+
+auto initRoundLayout(Rectangle const & rect,
+                     f32 const         borderRoundness,
+                     f32 const         lineThickness,
+                     Color const &     borderColor,
+                     bool const        isHidden = false) -> u32
+{
+    UIRouondLayout const layout {.rect            = rect,
+                                 .borderRoundness = borderRoundness,
+                                 .lineThickness   = lineThickness,
+                                 .borderColor     = borderColor,
+                                 .id              = layoutArray.size(),
+                                 .isHidden        = isHidden};
+    layoutArray.emplace_back(layout);
+    return layout.id;
+}
+
+// position 0,0 is centerned by default
+auto makeLable(char const*     text,
+               Color const &   txtColor,
+               u32 const       fontIndx         = 0,
+               u16 const       fontSize         = 20,
+               Vector2 const & position         = {0, 0},
+               f32 const       fontSpace        = 2.f,
+               bool const      isHidden         = false,
+               i32 const       parentLayoutIndx = -1) -> u32
+{
+    RA_Util::checkAtRuntime((fontSize <= 0), "font scale should not be zero");
+    RA_Util::checkAtRuntime((fontIndx < 0), "font index is not valid"sv);
+    Font const currentFont = fontsArray[cast(u32, fontIndx)];
+    f32 const currentFontSize = cast(f32, currentFont.baseSize) * (fontSize / 100.f);
+    lablesTextArray.emplace_back(text);
+
+    UILable lable {.position    = position,
+                   .textColor   = txtColor,
+                   .fontIndx    = fontIndx,
+                   .textIndx    = (lablesTextArray.size() - 1),
+                   .fontSize    = currentFontSize,
+                   .fontSpacing = fontSpace,
+                   .textSize = MeasureTextEx(currentFont, text, currentFontSize, fontSpace),
+                   .id         = lablesArray.size(),
+                   .parentInxd = parentLayoutIndx,
+                   .isHidden   = isHidden};
+
+    if (parentLayoutIndx >= 0)
+    {
+        Rectangle const parentLayout = layoutArray[cast(u32, parentLayoutIndx)].rect;
+        lable.position.x = parentLayout.x + (parentLayout.width / 2.f) -
+                           lable.textSize.x / 2.f;
+        lable.position.y = parentLayout.y + (parentLayout.height / 2.f) -
+                           lable.textSize.y / 2;
+    }
+
+    lablesArray.emplace_back(lable);
+    return lable.id;
+}
+auto updateLable(u32 const       lableID,
+                 char const*     text,
+                 Color const &   txtColor,
+                 u16 const       fontSize = 20,
+                 bool const      isHidden = false,
+                 Vector2 const & position = {0, 0})
+{
+    lablesTextArray[lablesArray[lableID].textIndx] = text;
+    lablesArray[lableID].textColor                 = txtColor;
+    lablesArray[lableID].fontSize                  = fontSize;
+    lablesArray[lableID].position                  = position;
+    lablesArray[lableID].isHidden                  = isHidden;
+}
+auto drawRoundLayout(i32 const layoutID) -> void
+{
+    RA_Util::checkAtRuntime((layoutID < 0), "layout id is invalid");
+
+    auto const lay = layoutArray[cast(u32, layoutID)];
+    if (lay.isHidden)
+        return;
+    DrawRectangleRoundedLinesEx(lay.rect,
+                                lay.borderRoundness,
+                                1,
+                                lay.lineThickness,
+                                lay.borderColor);
+}
+
+// font scale should be bigger than 0.0
+auto drawLable(u32 const lableID) -> void
+{
+    RA_Util::checkAtRuntime((lableID < 0), "lable id is invalid");
+    UILable const & lable       = lablesArray[lableID];
+    Font const &    currentFont = fontsArray[lable.fontIndx];
+    char const*     text        = lablesTextArray[lable.textIndx].c_str();
+    if (text == nullptr || lable.fontSize == 0 || lable.isHidden)
+        return;
+
+    DrawTextEx(currentFont,
+               text,
+               lable.position,
+               lable.fontSize,
+               lable.fontSpacing,
+               lable.textColor);
+}
+
+// auto drawIcon(u32 const iconId)
+// {
+// }
+
+auto drawRoundButton(u32 const btnID)
+{
+    RA_Util::checkAtRuntime((btnID < 0), "btn id is invalid");
+    auto const currentBtn = buttonsArray[btnID];
+    if (currentBtn.isHidden)
+        return;
+    if (currentBtn.layoutIndx >= 0)
+        drawRoundLayout(currentBtn.layoutIndx);
+    // if (currentBtn.iconIndx >= 0)
+    //     drawIcon(currentBtn.iconIndx);
+    if (currentBtn.lableIndx >= 0)
+        drawLable(currentBtn.lableIndx);
+}
+
+auto makeRoundButton(Rectangle const & rect,
+                     f32 const         borderRoundness,
+                     f32 const         borderThickness,
+                     Color const &     borderColor,
+                     char const*       text,
+                     Color const &     txtColor,
+                     u16 const         fontSize,
+                     bool const        isHidden,
+                     u32 const         fontIndx = 0) -> u32
+{
+    u32 const layid = initRoundLayout(rect,
+                                      borderRoundness,
+                                      borderThickness,
+                                      borderColor,
+                                      isHidden);
+    // RA_Util::checkAtRuntime((layid < 0), "layout id is negative");
+    u32 const lblid = makeLable(text, txtColor, fontIndx, fontSize, Vector2 {}, 2.f, isHidden, layid);
+    // RA_Util::checkAtRuntime((lblid < 0), "lable id is negative");
+    u32 const btnid = initRoundButton(layid,
+                                      lblid
+                                      /* , i32 const iconIndx*/,
+                                      isHidden);
+    // RA_Util::checkAtRuntime((btnid < 0), "btn id is negative");
+    return btnid;
+}
+
+auto getBtnRect(u32 const btnID) -> Rectangle
+{
+    return layoutArray[cast(u32, buttonsArray[btnID].layoutIndx)].rect;
+}
+}  // namespace RA_UI
+
+// render data of an occupied cell (indexed by cell id)
+struct PlayerShapeInfo
+{
+    Rectangle rect;
+    Color     color;
+    u8        id;
+    f64       placedTime;  // GetTime() of the move (cell animation)
+
+    PlayerShapeInfo(Rectangle const & r, Color const & c, u8 const i, f64 const t) :
+    rect {r},
+    color {c},
+    id {i},
+    placedTime {t}
+    {
+    }
+
+    PlayerShapeInfo()  = default;
+    ~PlayerShapeInfo() = default;
+    auto operator=(PlayerShapeInfo const & rhs) -> PlayerShapeInfo &
+    {
+        if (this == &rhs)
+            return *this;
+        rect       = rhs.rect;
+        color      = rhs.color;
+        id         = rhs.id;
+        placedTime = rhs.placedTime;
+        return *this;
+    }
+};
+struct Particle
+{
+    Rectangle rect;
+    b2BodyId  bodyID;
+    Vector2   previous;  // screen position at the previous tick
+    Vector2   current;   // screen position at the last tick
+};
+enum class GameState : u8
+{
+    none = 0,
+    win,
+    tie,
+    end
+};
+
+// game glob vars
+i32                    gHeight {0};
+i32                    gWidth {0};
+u32                    winUIFramCounter {0};
+u32                    winFrameLimit {10};
+u32                    winAnimResetFrame {40};
+u8                     winAnimState {1};
+bool                   canReset {false};
+Vector2                uIPointAnimationWin {0.f, 0.f};
+GameState              currentState {GameState::none};
+RA_Util::GRandom const gRandom(-1200.f, 1500.f);
+RA_Util::GRandom const littleRandom(5.f, 15.f);
+// constexpr u16 const    fps {60};
+constexpr u8 const row    = 3;
+constexpr u8 const column = 3;
+constexpr u8 const goal   = 3;
+// presentation of each player (moves, turn and win check are in RA_Game::Board)
+struct Player
+{
+    Color const rectColor;
+    str const   name;
+    u8 const    id;
+};
+
+
+namespace RA_Render
+{
+
+/*
+ *@Goal: vertex of the quad batch
+ *@Note: custom is bound to vertexTexCoord2 (location 5) as vec4 for custom
+ * shaders (owner of a cell, sdf shape params, ...) default shader ignore it
+ */
+struct BatchVertex
+{
+    Vector2            position;
+    Vector2            texcoord;
+    Color              color;
+    std::array<f32, 4> custom;
+};
+
+// indices are u16 (rlDrawVertexArrayElements) => at most 16384 quads per draw
+inline constexpr u32 maxBatchQuads {65'536 / 4};
+
+/*
+ *@Goal: quads written into one pre sized vertex array and drawn in one call
+ *@Note: when vao is not supported (some gles2 devices) it use rlgl immediate
+ * mode (custom attribute is lost in that case)
+ */
+struct QuadBatch
+{
+    std::vector<BatchVertex> vertices;  // 4 per quad
+    u32                      quadCount {0};
+    u32                      capacity {0};
+    u32                      vaoID {0};
+    u32                      vboID {0};
+    u32                      eboID {0};
+};
+
+[[nodiscard]] [[maybe_unused]]
+auto makeQuadBatch(u32 const capacity) -> QuadBatch
+{
+    QuadBatch batch {};
+    batch.capacity = std::min(capacity, maxBatchQuads);
+    batch.vertices.resize(cast(std::size_t, batch.capacity) * 4);
+
+    // same quad indices as raylib batch (tl, bl, br, tr)
+    std::vector<u16> indices(cast(std::size_t, batch.capacity) * 6);
+    for (u32 i = 0; i < batch.capacity; ++i)
+    {
+        auto const first   = cast(u16, i * 4);
+        indices[(i * 6)]     = first;
+        indices[(i * 6) + 1] = cast(u16, first + 1);
+        indices[(i * 6) + 2] = cast(u16, first + 2);
+        indices[(i * 6) + 3] = first;
+        indices[(i * 6) + 4] = cast(u16, first + 2);
+        indices[(i * 6) + 5] = cast(u16, first + 3);
+    }
+
+    batch.vaoID = rlLoadVertexArray();
+    if (!rlEnableVertexArray(batch.vaoID))
+    {
+        batch.vaoID = 0;
+        return batch;
+    }
+    batch.vboID = rlLoadVertexBuffer(nullptr,
+                                     cast(i32, batch.vertices.size() *
+                                                   sizeof(BatchVertex)),
+                                     true);
+    constexpr auto stride = cast(i32, sizeof(BatchVertex));
+    rlSetVertexAttribute(RL_DEFAULT_SHADER_ATTRIB_LOCATION_POSITION,
+                         2,
+                         RL_FLOAT,
+                         false,
+                         stride,
+                         cast(i32, offsetof(BatchVertex, position)));
+    rlEnableVertexAttribute(RL_DEFAULT_SHADER_ATTRIB_LOCATION_POSITION);
+    rlSetVertexAttribute(RL_DEFAULT_SHADER_ATTRIB_LOCATION_TEXCOORD,
+                         2,
+                         RL_FLOAT,
+                         false,
+                         stride,
+                         cast(i32, offsetof(BatchVertex, texcoord)));
+    rlEnableVertexAttribute(RL_DEFAULT_SHADER_ATTRIB_LOCATION_TEXCOORD);
+    rlSetVertexAttribute(RL_DEFAULT_SHADER_ATTRIB_LOCATION_COLOR,
+                         4,
+                         RL_UNSIGNED_BYTE,
+                         true,
+                         stride,
+                         cast(i32, offsetof(BatchVertex, color)));
+    rlEnableVertexAttribute(RL_DEFAULT_SHADER_ATTRIB_LOCATION_COLOR);
+    rlSetVertexAttribute(RL_DEFAULT_SHADER_ATTRIB_LOCATION_TEXCOORD2,
+                         4,
+                         RL_FLOAT,
+                         false,
+                         stride,
+                         cast(i32, offsetof(BatchVertex, custom)));
+    rlEnableVertexAttribute(RL_DEFAULT_SHADER_ATTRIB_LOCATION_TEXCOORD2);
+    batch.eboID = rlLoadVertexBufferElement(indices.data(),
+                                            cast(i32, indices.size() * sizeof(u16)),
+                                            false);
+    rlDisableVertexArray();
+    return batch;
+}
+
+[[maybe_unused]]
+auto unloadQuadBatch(QuadBatch & batch) noexcept -> void
+{
+    if (batch.vaoID != 0)
+    {
+        rlUnloadVertexBuffer(batch.vboID);
+        rlUnloadVertexBuffer(batch.eboID);
+        rlUnloadVertexArray(batch.vaoID);
+    }
+    batch = QuadBatch {};
+}
+
+/*
+ *@Goal: add a quad (dest is in screen space, uv is 0 to 1)
+ *@Note: return false if the batch is full (caller should flush)
+ */
+[[nodiscard]] [[maybe_unused]]
+inline auto pushQuad(QuadBatch &                batch,
+                     Rectangle const &          dest,
+                     Rectangle const &          uv,
+                     Color const                color,
+                     std::array<f32, 4> const & custom = {}) noexcept -> bool
+{
+    if (batch.quadCount == batch.capacity)
+        return false;
+    BatchVertex* const vertex = batch.vertices.data() +
+                                (cast(std::size_t, batch.quadCount) * 4);
+    f32 const          right  = dest.x + dest.width;
+    f32 const          bottom = dest.y + dest.height;
+    vertex[0] = {{dest.x, dest.y}, {uv.x, uv.y}, color, custom};
+    vertex[1] = {{dest.x, bottom}, {uv.x, uv.y + uv.height}, color, custom};
+    vertex[2] = {{right, bottom}, {uv.x + uv.width, uv.y + uv.height}, color, custom};
+    vertex[3] = {{right, dest.y}, {uv.x + uv.width, uv.y}, color, custom};
+    ++batch.quadCount;
+    return true;
+}
+
+/*
+ *@Goal: draw all the quads with one draw call then empty the batch
+ *@Note: raylib internal batch is flushed first so drawing order is kept
+ */
+[[maybe_unused]]
+auto flushQuadBatch(QuadBatch & batch, Shader const & shader, u32 const textureID) noexcept
+    -> void
+{
+    if (batch.quadCount == 0)
+        return;
+    rlDrawRenderBatchActive();
+
+    if (batch.vaoID == 0)  // immediate mode fallback
+    {
+        // raylib batch has no vertexTexCoord2 => custom is set as the constant
+        // value of that attribute, one quad per draw (only if the shader use it)
+        i32 const customLocation = shader.locs[SHADER_LOC_VERTEX_TEXCOORD02];
+        u32 const quadsPerDraw   = customLocation >= 0 ? 1 : batch.quadCount;
+        rlSetShader(shader.id, shader.locs);
+        for (u32 first = 0; first < batch.quadCount; first += quadsPerDraw)
+        {
+            if (customLocation >= 0)
+                rlSetVertexAttributeDefault(customLocation,
+                                            batch.vertices[first * 4].custom.data(),
+                                            RL_SHADER_ATTRIB_VEC4,
+                                            1);
+            // texture of the draw is reset after each flush
+            rlSetTexture(textureID);
+            rlBegin(RL_QUADS);
+            for (u32 i = first * 4; i < (first + quadsPerDraw) * 4; ++i)
+            {
+                BatchVertex const & vertex = batch.vertices[i];
+                rlColor4ub(vertex.color.r, vertex.color.g, vertex.color.b, vertex.color.a);
+                rlTexCoord2f(vertex.texcoord.x, vertex.texcoord.y);
+                rlVertex2f(vertex.position.x, vertex.position.y);
+            }
+            rlEnd();
+            if (customLocation >= 0)
+                rlDrawRenderBatchActive();  // constant is read at draw time
+        }
+        rlSetTexture(0);
+        rlDrawRenderBatchActive();
+        rlSetShader(rlGetShaderIdDefault(), rlGetShaderLocsDefault());
+        batch.quadCount = 0;
+        return;
+    }
+
+    constexpr std::array<f32, 4> const white {1.f, 1.f, 1.f, 1.f};
+    constexpr i32 const                textureSlot {0};
+    rlEnableShader(shader.id);
+    rlSetUniformMatrix(shader.locs[SHADER_LOC_MATRIX_MVP],
+                       MatrixMultiply(rlGetMatrixModelview(), rlGetMatrixProjection()));
+    rlSetUniform(shader.locs[SHADER_LOC_COLOR_DIFFUSE],
+                 white.data(),
+                 RL_SHADER_UNIFORM_VEC4,
+                 1);
+    rlSetUniform(shader.locs[SHADER_LOC_MAP_DIFFUSE],
+                 &textureSlot,
+                 RL_SHADER_UNIFORM_SAMPLER2D,
+                 1);
+    rlActiveTextureSlot(textureSlot);
+    rlEnableTexture(textureID);
+
+    rlEnableVertexArray(batch.vaoID);
+    rlUpdateVertexBuffer(batch.vboID,
+                         batch.vertices.data(),
+                         cast(i32, batch.quadCount * 4 * sizeof(BatchVertex)),
+                         0);
+    rlDrawVertexArrayElements(0, cast(i32, batch.quadCount * 6), nullptr);
+    rlDisableVertexArray();
+
+    rlDisableTexture();
+    rlDisableShader();
+    batch.quadCount = 0;
+}
+
+/*
+ *@Goal: raylib default shader (texture * vertex color)
+ */
+[[nodiscard]] [[maybe_unused]]
+inline auto defaultShader() noexcept -> Shader
+{
+    return Shader {.id = rlGetShaderIdDefault(), .locs = rlGetShaderLocsDefault()};
+}
+
+/*
+ *@Goal: skyline rectangle packer (bottom-left: lowest top edge wins)
+ *@Note: skyline is the top edge of the packed rectangles from left to right
+ * => each insert is O(nodes) and nothing is ever moved
+ */
+struct SkylinePacker
+{
+    struct Node
+    {
+        i32 x;
+        i32 y;
+        i32 width;
+    };
+
+    std::vector<Node> skyline;
+    i32               width;
+    i32               height;
+};
+
+[[nodiscard]] [[maybe_unused]]
+auto makeSkylinePacker(i32 const width, i32 const height) -> SkylinePacker
+{
+    return SkylinePacker {.skyline = {{.x = 0, .y = 0, .width = width}},
+                          .width   = width,
+                          .height  = height};
+}
+
+/*
+ *@Goal: top-left of a free width x height area (nullopt => does not fit)
+ */
+[[nodiscard]] [[maybe_unused]]
+auto packRect(SkylinePacker & packer, i32 const width, i32 const height)
+    -> std::optional<std::pair<i32, i32>>
+{
+    using Node = SkylinePacker::Node;
+    std::vector<Node> & skyline = packer.skyline;
+    // y of a rect that start at node index (highest node under it) or -1
+    auto const fitAt = [&](std::size_t index) -> i32 {
+        if (skyline[index].x + width > packer.width)
+            return -1;
+        i32 y {0};
+        for (i32 remaining = width; remaining > 0; remaining -= skyline[index++].width)
+        {
+            y = std::max(y, skyline[index].y);
+            if (y + height > packer.height)
+                return -1;
+        }
+        return y;
+    };
+
+    std::size_t best {skyline.size()};
+    i32         bestTop {std::numeric_limits<i32>::max()};
+    i32         bestWidth {std::numeric_limits<i32>::max()};
+    for (std::size_t i = 0; i < skyline.size(); ++i)
+    {
+        i32 const y = fitAt(i);
+        if (y < 0)
+            continue;
+        if ((y + height) < bestTop || ((y + height) == bestTop && skyline[i].width < bestWidth))
+        {
+            best      = i;
+            bestTop   = y + height;
+            bestWidth = skyline[i].width;
+        }
+    }
+    if (best == skyline.size())
+        return std::nullopt;
+
+    // new node cover the nodes under the rect (cut or remove them)
+    i32 const x = skyline[best].x;
+    skyline.insert(skyline.begin() + cast(std::ptrdiff_t, best),
+                   Node {.x = x, .y = bestTop, .width = width});
+    for (std::size_t i = best + 1; i < skyline.size();)
+    {
+        i32 const covered = (x + width) - skyline[i].x;
+        if (covered <= 0)
+            break;
+        if (covered < skyline[i].width)
+        {
+            skyline[i].x += covered;
+            skyline[i].width -= covered;
+            break;
+        }
+        skyline.erase(skyline.begin() + cast(std::ptrdiff_t, i));
+    }
+    // same height neighbours are one node
+    for (std::size_t i = 0; i + 1 < skyline.size();)
+    {
+        if (skyline[i].y == skyline[i + 1].y)
+        {
+            skyline[i].width += skyline[i + 1].width;
+            skyline.erase(skyline.begin() + cast(std::ptrdiff_t, i + 1));
+        }
+        else
+            ++i;
+    }
+    return std::pair {x, bestTop - height};
+}
+
+/*
+ *@Goal: where a sprite is in the atlas (rect in pixels of the page, uv 0 to 1)
+ */
+struct AtlasRegion
+{
+    u32       page;
+    Rectangle rect;
+    Rectangle uv;
+};
+
+/*
+ *@Goal: runtime texture atlas => sprites of all kinds share a texture (one
+ * bind, one batch)
+ *@Note: pages are render textures (images are uploaded, textures are drawn
+ * into them) and a new page is added when the others are full
+ *@Note: padding is transparent => bilinear filter does not bleed
+ */
+struct TextureAtlas
+{
+    std::vector<RenderTexture2D> pages;
+    std::vector<SkylinePacker>   packers;  // same index as pages
+    i32                          pageSize;
+    i32                          padding;
+};
+
+[[nodiscard]] [[maybe_unused]]
+auto makeTextureAtlas(i32 const pageSize, i32 const padding) -> TextureAtlas
+{
+    return TextureAtlas {.pages = {}, .packers = {}, .pageSize = pageSize, .padding = padding};
+}
+
+[[maybe_unused]]
+auto unloadTextureAtlas(TextureAtlas & atlas) noexcept -> void
+{
+    for (auto const & page : atlas.pages)
+        UnloadRenderTexture(page);
+    atlas.pages.clear();
+    atlas.packers.clear();
+}
+
+/*
+ *@Goal: reserve a width x height region (first page that has space)
+ *@Note: nullopt => it is bigger than a page
+ *@Warning: a new page use texture mode => call it outside of texture modes
+ */
+[[nodiscard]] [[maybe_unused]]
+auto allocateRegion(TextureAtlas & atlas, i32 const width, i32 const height)
+    -> std::optional<AtlasRegion>
+{
+    i32 const paddedWidth  = width + (atlas.padding * 2);
+    i32 const paddedHeight = height + (atlas.padding * 2);
+    if (width <= 0 || height <= 0 || paddedWidth > atlas.pageSize ||
+        paddedHeight > atlas.pageSize)
+        return std::nullopt;
+
+    auto const makeRegion = [&atlas, width, height](std::size_t const page,
+                                                    std::pair<i32, i32> const position) {
+        auto const size = cast(f32, atlas.pageSize);
+        Rectangle const rect {.x      = cast(f32, position.first + atlas.padding),
+                              .y      = cast(f32, position.second + atlas.padding),
+                              .width  = cast(f32, width),
+                              .height = cast(f32, height)};
+        return AtlasRegion {.page = cast(u32, page),
+                            .rect = rect,
+                            .uv   = Rectangle {rect.x / size,
+                                             rect.y / size,
+                                             rect.width / size,
+                                             rect.height / size}};
+    };
+    for (std::size_t i = 0; i < atlas.packers.size(); ++i)
+    {
+        if (auto const position = packRect(atlas.packers[i], paddedWidth, paddedHeight))
+            return makeRegion(i, *position);
+    }
+
+    RenderTexture2D const page = LoadRenderTexture(atlas.pageSize, atlas.pageSize);
+    SetTextureFilter(page.texture, TEXTURE_FILTER_BILINEAR);
+    BeginTextureMode(page);
+    ClearBackground(BLANK);
+    EndTextureMode();
+    atlas.pages.push_back(page);
+    atlas.packers.push_back(makeSkylinePacker(atlas.pageSize, atlas.pageSize));
+    return makeRegion(atlas.pages.size() - 1,
+                      *packRect(atlas.packers.back(), paddedWidth, paddedHeight));
+}
+
+/*
+ *@Goal: copy a cpu image into the atlas
+ */
+[[nodiscard]] [[maybe_unused]]
+auto insertImage(TextureAtlas & atlas, Image const & image) -> std::optional<AtlasRegion>
+{
+    auto const region = allocateRegion(atlas, image.width, image.height);
+    if (!region.has_value())
+        return std::nullopt;
+    Image pixels = ImageCopy(image);
+    ImageFormat(&pixels, PIXELFORMAT_UNCOMPRESSED_R8G8B8A8);
+    UpdateTextureRec(atlas.pages[region->page].texture, region->rect, pixels.data);
+    UnloadImage(pixels);
+    return region;
+}
+
+#ifdef DEBUG
+/*
+ *@Goal: read the region back from the page, it should be the same texels
+ * as the texture (same rows as insertImage and the region uv)
+ */
+[[maybe_unused]]
+auto checkAtlasRegion(TextureAtlas const & atlas,
+                      AtlasRegion const &  region,
+                      Texture2D const &    texture) -> void
+{
+    Image const page   = LoadImageFromTexture(atlas.pages[region.page].texture);
+    Image const source = LoadImageFromTexture(texture);
+    bool        isSame {true};
+    for (i32 y = 0; y < source.height && isSame; ++y)
+    {
+        for (i32 x = 0; x < source.width && isSame; ++x)
+        {
+            Color const expected = GetImageColor(source, x, y);
+            Color const copied   = GetImageColor(page,
+                                               cast(i32, region.rect.x) + x,
+                                               cast(i32, region.rect.y) + y);
+            isSame = expected.r == copied.r && expected.g == copied.g &&
+                     expected.b == copied.b && expected.a == copied.a;
+        }
+    }
+    UnloadImage(source);
+    UnloadImage(page);
+    RA_Util::checkAtRuntime(!isSame, "atlas region is not a copy of the texture"sv);
+}
+#endif  // DEBUG
+
+/*
+ *@Goal: copy a gpu texture (e.g. render to texture result) into the atlas
+ *@Note: copied without blending (alpha is kept as it is)
+ *@Note: texture mode is y flipped => drawn at the flipped rows with a flipped
+ * source, so the texels are in the same rows as the region rect and uv
+ *@Warning: it use texture mode => call it outside of other texture modes
  */
 [[nodiscard]] [[maybe_unused]]
-auto index2RectOnGrid(u16 const index, GridInfo const & grid) noexcept -> Rectangle
+auto insertTexture(TextureAtlas & atlas, Texture2D const & texture)
+    -> std::optional<AtlasRegion>
 {
-    auto const point = index2PointOnGrid(index, grid);
-    return Rectangle {.x      = point.x,
-                      .y      = point.y,
-                      .width  = grid.cellSize.x,
-                      .height = grid.cellSize.y
+    auto const region = allocateRegion(atlas, texture.width, texture.height);
+    if (!region.has_value())
+        return std::nullopt;
+    Rectangle const dest {.x      = region->rect.x,
+                          .y      = cast(f32, atlas.pageSize) - region->rect.y -
+                               region->rect.height,
+                          .width  = region->rect.width,
+                          .height = region->rect.height};
+    BeginTextureMode(atlas.pages[region->page]);
+    rlSetBlendFactors(RL_ONE, RL_ZERO, RL_FUNC_ADD);
+    BeginBlendMode(BLEND_CUSTOM);
+    DrawTexturePro(texture,
+                   Rectangle {0.f, 0.f, cast(f32, texture.width), -cast(f32, texture.height)},
+                   dest,
+                   Vector2 {},
+                   0.f,
+                   WHITE);
+    EndBlendMode();
+    EndTextureMode();
+#ifdef DEBUG
+    checkAtlasRegion(atlas, *region, texture);
+#endif  // DEBUG
+    return region;
+}
+
+/*
+ *@Note: by value (id and size), pages move when a new page is added
+ */
+[[nodiscard]] [[maybe_unused]]
+inline auto atlasTexture(TextureAtlas const & atlas, AtlasRegion const & region) noexcept
+    -> Texture2D
+{
+    return atlas.pages[region.page].texture;
+}
 
+/*
+ *@Goal: shader with a cpu copy of its float uniforms (float ... vec4)
+ *@Note: locations are resolved once by name, setUniform only write the copy
+ * (same value => skipped) and uploadUniforms send the changed ones
+ *@Note: call uploadUniforms right before the shader is used for drawing
+ */
+struct ShaderUniforms
+{
+    struct Uniform
+    {
+        str                name;
+        i32                location;
+        i32                type;  // SHADER_UNIFORM_FLOAT + size - 1
+        u32                size;  // float count
+        std::array<f32, 4> value {};
+        bool               isDirty {true};  // new uniform is always uploaded
     };
+
+    Shader               shader;
+    str                  counterName;  // profiler counter of skipped uploads
+    std::vector<Uniform> uniforms {};
+    u32                  skipCount {0};  // since the last uploadUniforms
+};
+
+[[nodiscard]] [[maybe_unused]]
+auto makeShaderUniforms(Shader const & shader, str_v const name) -> ShaderUniforms
+{
+    return ShaderUniforms {.shader      = shader,
+                           .counterName = str {name} + " skipped uniforms"};
 }
 
 /*
- *@Goal: move a point(p1) towards the p2 based on some rate(pixelPerFrame)
+ *@Goal: resolve the uniform location and keep the initial value
+ *@Note: missing uniform (optimized out) keep location -1 => never uploaded
+ *@Warning: value should be 1 to 4 floats
  */
 [[maybe_unused]]
-auto moveTowards(Vector2 & p1, Vector2 const & p2, u16 const pixelPerFrame) noexcept
+auto addUniform(ShaderUniforms & uniforms, str_v const name, std::span<f32 const> const value)
     -> void
 {
-    f32 const dx     = p2.x - p1.x;
-    f32 const dy     = p2.y - p1.y;
-    f32 const length = std::sqrt((dx * dx) + (dy * dy));
-
-    if (length > 0.f && (pixelPerFrame * GetFrameTime()) < length)
-    {  // Avoid overshooting
-        p1.x += (dx / length) * pixelPerFrame * GetFrameTime();
-        p1.y += (dy / length) * pixelPerFrame * GetFrameTime();
-    }
-    else
-        p1 = p2;  // Snap to target if within step size
+    assert(!value.empty() && value.size() <= 4);
+    str uniformName {name};
+    i32 const location = GetShaderLocation(uniforms.shader, uniformName.c_str());
+    ShaderUniforms::Uniform & uniform =
+        uniforms.uniforms.emplace_back(ShaderUniforms::Uniform {
+            .name     = std::move(uniformName),
+            .location = location,
+            .type     = SHADER_UNIFORM_FLOAT + cast(i32, value.size()) - 1,
+            .size     = cast(u32, value.size())});
+    std::ranges::copy(value, uniform.value.begin());
 }
 
 /*
- *@Goal: draw a rectangle like a line
+ *@Goal: update the cpu copy, mark it dirty only if the value is changed
+ *@Note: linear search by name (a shader has a few uniforms)
  */
 [[maybe_unused]]
-auto drawGoodLine(Vector2 const & start,
-                  Vector2 const & end,
-                  u16 const       lineThickness,
-                  Color const &   color) noexcept -> void
+auto setUniform(ShaderUniforms & uniforms, str_v const name, std::span<f32 const> const value)
+    -> void
 {
-    f32 const rotation      = Vector2LineAngle(start, end) * -RAD2DEG;
-    f32 const currentLength = Vector2Length(start - end);
-    f32 const currentHeight = lineThickness;
-    f32       currentX      = 0.f;
-    f32       currentY      = 0.f;
-    u16 const tempRotation  = cast(u16, rotation);
-    // for angle that bigger than 135
-    if (tempRotation >= 135)
-    {
-        currentX = start.x;
-        currentY = start.y + (currentHeight * .5f);
-    }
-    // for 90 deg angle
-    else if (tempRotation == 90)
-    {
-        currentX = start.x + (currentHeight * .5f);
-        currentY = start.y;
-    }
-    // for grater than 40 deg
-    else if (tempRotation >= 40)
-    {
-        currentX = start.x;
-        currentY = start.y;
-    }
-    else  // its for 0 deg
+    auto const found = std::ranges::find(uniforms.uniforms, name, &ShaderUniforms::Uniform::name);
+    assert(found != uniforms.uniforms.end() && value.size() == found->size);
+    auto const current = std::span {found->value}.first(found->size);
+    if (std::ranges::equal(value, current))
     {
-        currentX = start.x;
-        currentY = start.y - (currentHeight * .5f);
+        ++uniforms.skipCount;
+        return;
     }
-    DrawRectanglePro({.x      = currentX,
-                      .y      = currentY,
-                      .width  = currentLength,
-                      .height = currentHeight},
-                     {},
-                     rotation,
-                     color);
+    // value that was not uploaded yet is replaced => that upload is skipped
+    if (found->isDirty)
+        ++uniforms.skipCount;
+    std::ranges::copy(value, current.begin());
+    found->isDirty = true;
 }
-// TODO: need some adjustment for y limitation from boundries
-auto isClippingForRender(Vector2 const & pos, Rectangle const & boundry) noexcept
-    -> bool
+
+[[maybe_unused]]
+auto setUniform(ShaderUniforms & uniforms, str_v const name, f32 const value) -> void
 {
-    // Demorgan law
-    return (pos.y > boundry.height || pos.x > boundry.width || pos.x < boundry.x);
+    setUniform(uniforms, name, std::span<f32 const> {&value, 1});
 }
-}  // namespace RA_Util
 
-namespace RA_Anim
+/*
+ *@Goal: SetShaderValue only for the dirty uniforms
+ *@Note: report skipped uploads since the last call to the profiler
+ */
+[[maybe_unused]]
+auto uploadUniforms(ShaderUniforms & uniforms) -> void
 {
+    for (ShaderUniforms::Uniform & uniform : uniforms.uniforms)
+    {
+        if (!uniform.isDirty)
+            continue;
+        uniform.isDirty = false;
+        if (uniform.location < 0)
+            continue;
+        SetShaderValue(uniforms.shader, uniform.location, uniform.value.data(), uniform.type);
+    }
+    PROFILE_COUNTER(uniforms.counterName, uniforms.skipCount);
+    uniforms.skipCount = 0;
+}
 
-// TODO: it need a texture that support zBuffer
-struct AnimData
+/*
+ *@Goal: grid lines as a distance field shader over one quad (crisp at any
+ * columns, rows and resolution, nothing to rebuild on resize)
+ *@Note: shader did not compile (e.g. old gles driver) => genGridTexture is
+ * generated on the first draw and cached (the old texture path)
+ */
+struct GridRenderer
 {
-    Texture2D textureAnim;
-    Rectangle rect;
-    i32       counter;
-    i32       currentFrame;
-    i32       currentSpeed;
-    i32 const length;  // actual length is length -1
-    i32 const defaultSpeed;
-    i32 const speedMAX;
-    i32 const speedMIN;
+    Shader         shader;
+    ShaderUniforms uniforms;
+    Texture2D      fallback {};  // id 0 => not generated yet
 };
 
 [[nodiscard]] [[maybe_unused]]
-auto initAnim(str_v const fileName,
-              i32 const   animLenght,
-              i32 const   speed,
-              i32 const   speedMax) -> AnimData
+auto makeGridRenderer(RA_Shader::ShaderCache & shaderCache, RA_Util::GridInfo const & grid)
+    -> GridRenderer
 {
-    // str path;
-    // path.reserve(RA_Global::texturePath.size() + fileName.size());
-    // path.append(RA_Global::texturePath);
-    // path.append(fileName);
-    str const path {RA_Global::pathToFile(fileName, RA_Global::EFileType::Texture)};
-
-    if (FileExists(path.c_str()))
-    {
-        Texture2D const temp = LoadTexture(path.c_str());
-        return AnimData {.textureAnim  = temp,
-                         .rect         = {.x      = 0,
-                                          .y      = 0,
-                                          .width  = cast(f32, temp.width / animLenght),
-                                          .height = cast(f32, temp.height)},
-                         .counter      = 0,
-                         .currentFrame = 0,
-                         .currentSpeed = speed,
-                         .length       = animLenght,
-                         .defaultSpeed = speed,
-                         .speedMAX     = speedMax,
-                         .speedMIN     = 1};
-    }
-    std::cerr << "Error: " << fileName << " not found\n";
-    std::terminate();
+    Shader const shader = RA_Shader::loadShader(shaderCache, ""sv, "grid.fs"sv);
+    GridRenderer renderer {.shader = shader, .uniforms = makeShaderUniforms(shader, "grid"sv)};
+    std::array<f32, 2> const cells {cast(f32, grid.columnCount), cast(f32, grid.rowCount)};
+    std::array<f32, 2> const size {grid.rect.width, grid.rect.height};
+    f32 const                thickness {10.f};
+    addUniform(renderer.uniforms, "iCells"sv, cells);
+    addUniform(renderer.uniforms, "iSize"sv, size);
+    addUniform(renderer.uniforms, "iThickness"sv, std::span {&thickness, 1});
+    return renderer;
 }
+
 [[maybe_unused]]
-auto cleanAnim(AnimData & outData) noexcept -> void
+auto unloadGridRenderer(GridRenderer & renderer) noexcept -> void
 {
-    UnloadTexture(outData.textureAnim);
-    outData.rect = Rectangle {0, 0, 0, 0};
+    UnloadShader(renderer.shader);
+    if (renderer.fallback.id != 0)
+        UnloadTexture(renderer.fallback);
+    renderer.fallback = Texture2D {};
 }
 
 /*
- *@Goal: animation speed currection
- *@Note: it works as a input output param refrence
- *@Warning: internall function usage
+ *@Goal: draw the inner lines of the grid into dest
+ *@Note: pixelScale is target pixels per grid unit (lines stay thickness
+ * pixels of the screen at any render scale)
  */
 [[maybe_unused]]
-auto limitSpeedAnim(AnimData & outData) noexcept -> void
+auto drawGridLines(GridRenderer &            renderer,
+                   RA_Util::GridInfo const & grid,
+                   Rectangle const &         dest,
+                   f32 const                 pixelScale,
+                   f32 const                 thickness,
+                   Color const               color) -> void
 {
-    if (outData.currentSpeed > outData.speedMAX)
-        outData.currentSpeed = outData.speedMAX;
-    else if (outData.currentSpeed < outData.speedMIN)
-        outData.currentSpeed = outData.speedMIN;
+    PROFILE();
+    if (renderer.shader.id != rlGetShaderIdDefault())
+    {
+        std::array<f32, 2> const size {grid.rect.width * pixelScale,
+                                       grid.rect.height * pixelScale};
+        setUniform(renderer.uniforms, "iSize"sv, size);
+        setUniform(renderer.uniforms, "iThickness"sv, thickness * pixelScale);
+        uploadUniforms(renderer.uniforms);
+        // shapes texture coords are 0..1 over the rectangle
+        BeginShaderMode(renderer.shader);
+        DrawRectangleRec(dest, color);
+        EndShaderMode();
+        return;
+    }
+    // texture is 0.1 of the grid with 1 pixel lines => thickness is about 10
+    if (renderer.fallback.id == 0)
+        renderer.fallback = RA_Util::genGridTexture(grid, .1f, 5.f, WHITE, BLANK);
+    DrawTexturePro(renderer.fallback,
+                   Rectangle {0.f,
+                              0.f,
+                              cast(f32, renderer.fallback.width),
+                              cast(f32, renderer.fallback.height)},
+                   dest,
+                   Vector2 {},
+                   0.f,
+                   color);
 }
 
 /*
- *@Note: it works as a input output param refrence
+ *@Goal: full screen shader layer cached in its own (smaller) render target
+ *@Note: re-rendered at most rate times per second and only if time moved more
+ * than timeEpsilon, color change re-render at once; otherwise just upscaled
  */
-[[maybe_unused]]
-inline auto increaseAnimSpeed(AnimData & outData) noexcept -> void
+struct CachedLayer
 {
-    outData.currentSpeed += 1;
-    limitSpeedAnim(outData);
-}
+    RenderTexture2D    target;
+    f64                interval;  // 1 / rate seconds
+    f32                timeEpsilon;
+    f64                lastRender {0.0};
+    f32                lastTime {0.f};
+    std::array<f32, 3> lastColor {};
+    bool               isValid {false};  // false => render on the next check
+    u32                renderCount {0};
+};
+
 /*
- *@Note: it works as a input output param refrence
+ *@Goal: cache of a width x height layer at scale (0.5 => quarter of pixels)
  */
+[[nodiscard]] [[maybe_unused]]
+auto makeCachedLayer(i32 const width,
+                     i32 const height,
+                     f32 const scale,
+                     f32 const rate,
+                     f32 const timeEpsilon) -> CachedLayer
+{
+    CachedLayer layer {
+        .target      = LoadRenderTexture(std::max(cast(i32, cast(f32, width) * scale), 1),
+                                         std::max(cast(i32, cast(f32, height) * scale), 1)),
+        .interval    = 1.0 / cast(f64, rate),
+        .timeEpsilon = timeEpsilon};
+    // upscale should not be blocky
+    SetTextureFilter(layer.target.texture, TEXTURE_FILTER_BILINEAR);
+    return layer;
+}
+
 [[maybe_unused]]
-inline auto decreaseAnimSpeed(AnimData & outData) noexcept -> void
+auto unloadCachedLayer(CachedLayer & layer) noexcept -> void
 {
-    outData.currentSpeed -= 1;
-    limitSpeedAnim(outData);
+    UnloadRenderTexture(layer.target);
+    layer = CachedLayer {};
 }
 
 /*
- * @Note: it works as a input output param refrence
+ *@Goal: true if the layer should be rendered with these inputs (and mark it)
+ *@Note: caller set the uniforms and call renderCachedLayer when it is true
  */
-[[maybe_unused]]
-inline auto resetAnimSpeed(AnimData & outData) noexcept -> void
+[[nodiscard]] [[maybe_unused]]
+auto shouldRenderLayer(CachedLayer &                 layer,
+                       f64 const                     now,
+                       f32 const                     time,
+                       std::span<f32 const, 3> const color) noexcept -> bool
 {
-    outData.currentSpeed = outData.defaultSpeed;
+    bool const isNewColor = !std::ranges::equal(color, layer.lastColor);
+    bool const isDue      = (now - layer.lastRender) >= layer.interval &&
+                            std::fabs(time - layer.lastTime) >= layer.timeEpsilon;
+    if (layer.isValid && !isNewColor && !isDue)
+        return false;
+    layer.lastRender = now;
+    layer.lastTime   = time;
+    std::ranges::copy(color, layer.lastColor.begin());
+    layer.isValid = true;
+    return true;
 }
+
 /*
- * @Note: it works as a input output param refrence
- * @Warning: internall function usage for updateAnim
+ *@Goal: run the shader over the whole cached target
+ *@Warning: it use texture mode => call it outside of other texture modes
  */
 [[maybe_unused]]
-inline auto resetAnim(AnimData & outData) noexcept -> void
+auto renderCachedLayer(CachedLayer & layer, Shader const & shader) noexcept -> void
 {
-    outData.currentFrame = 0;
+    PROFILE();
+    BeginTextureMode(layer.target);
+    ClearBackground(BLANK);
+    BeginShaderMode(shader);
+    DrawRectangle(0, 0, layer.target.texture.width, layer.target.texture.height, WHITE);
+    EndShaderMode();
+    EndTextureMode();
+    ++layer.renderCount;
 }
-// TODO: zBuffer needed
+
+/*
+ *@Goal: upscale the cached layer into dest
+ *@Note: source height is negative => same orientation as drawing it directly
+ */
 [[maybe_unused]]
-auto renderAnim(AnimData const & data,
-                Vector2 const &  pos,
-                Color const      tint = WHITE) noexcept -> void
+auto drawCachedLayer(CachedLayer const & layer, Rectangle const & dest) noexcept -> void
 {
-    DrawTextureRec(data.textureAnim, data.rect, pos, tint);
+    Texture2D const & texture = layer.target.texture;
+    DrawTexturePro(texture,
+                   Rectangle {0.f, 0.f, cast(f32, texture.width), -cast(f32, texture.height)},
+                   dest,
+                   Vector2 {},
+                   0.f,
+                   WHITE);
 }
 
 /*
- *@Goal: get ready animation info for render them in gameloop
+ *@Goal: dynamic resolution => render scale of the main target follow the
+ * frame time between minScale and maxScale
+ *@Note: each level has its own render target (loaded on first use and kept)
+ * => a change of level never reallocate
+ *@Note: over budget => one level down at once, stable for probeFrames => try
+ * one level up (probe time doubles after each drop so it does not flicker)
  */
-[[maybe_unused]]
-auto updateAnim(AnimData & data) noexcept -> void
+struct DynamicResolution
 {
-    data.counter++;
-    if (data.counter >= RA_Global::animationFPS / data.currentSpeed)
-    {
-        data.counter = 0;
-        // speed currection
-        limitSpeedAnim(data);
-        data.currentFrame++;
-
-        if (data.currentFrame > (data.length - 1))  // start animation frame is zero
-            resetAnim(data);
+    std::vector<f32>             scales;   // ascending, of the full resolution
+    std::vector<RenderTexture2D> targets;  // same index as scales (id 0 => not loaded)
+    i32                          width;    // full resolution
+    i32                          height;
+    u32                          level;
+    f32                          budgetSeconds;  // 1 / target fps
+    f32                          averageSeconds;
+    u32                          stableFrames {0};
+    u32                          probeFrames;
+    u32                          cooldownFrames;  // frames to wait after a change
+};
 
-        data.rect.x = cast(f32, data.currentFrame) *
-                      cast(f32, data.textureAnim.width) / cast(f32, data.length);
+[[nodiscard]] [[maybe_unused]]
+auto makeDynamicResolution(i32 const width,
+                           i32 const height,
+                           f32 const minScale,
+                           f32 const maxScale,
+                           u32 const levelCount,
+                           f32 const targetFps) -> DynamicResolution
+{
+    u32 const         count = std::max(levelCount, 2U);
+    DynamicResolution resolution {.scales         = std::vector<f32>(count),
+                                  .targets        = std::vector<RenderTexture2D>(count),
+                                  .width          = width,
+                                  .height         = height,
+                                  .level          = count - 1,  // fast machines stay here
+                                  .budgetSeconds  = 1.f / targetFps,
+                                  .averageSeconds = 1.f / targetFps,
+                                  .probeFrames    = cast(u32, targetFps * 2.f),
+                                  .cooldownFrames = cast(u32, targetFps)};
+    for (u32 i = 0; i < count; ++i)
+    {
+        resolution.scales[i] = minScale + ((maxScale - minScale) * cast(f32, i) /
+                                           cast(f32, count - 1));
     }
+    return resolution;
 }
 
-template <std::size_t size>
 [[maybe_unused]]
-auto defineCircles(RA_Util::GridInfo const &    gridInfo,
-                   std::array<u8, size> const & indexesCausesWin)
-    -> std::array<Vector2, size>
+auto unloadDynamicResolution(DynamicResolution & resolution) noexcept -> void
 {
-    std::array<Vector2, size> circles {};
-    for (size_t i = 0; i < indexesCausesWin.size(); ++i)
+    for (auto const & target : resolution.targets)
     {
-        circles[i] = RA_Util::index2CenterPointOnGrid(indexesCausesWin[i], gridInfo);
+        if (target.id != 0)
+            UnloadRenderTexture(target);
     }
-    return circles;
+    resolution.targets.clear();
 }
 
-template <std::size_t size>
+/*
+ *@Goal: feed the frame time, return true if the level is changed
+ */
 [[maybe_unused]]
-auto drawAnimCircles(u32 const                         currentFrame,
-                     u32 &                             inFrameLimit,
-                     u8 &                              inAnimState,
-                     u32 const                         resetFrame,
-                     u32 const                         jumpFrame,
-                     u16 const                         jumpState,
-                     std::array<Vector2, size> const & circles,
-                     Color const                       color) -> void
+auto updateDynamicResolution(DynamicResolution & resolution, f32 const frameSeconds) noexcept
+    -> bool
 {
-    for (u16 i = 0; i < cast(u16, circles.size()); ++i)
+    // smoothed => one slow frame does not change the level
+    resolution.averageSeconds += (std::min(frameSeconds, .25f) - resolution.averageSeconds) *
+                                 .1f;
+    if (resolution.cooldownFrames != 0)
     {
-        if (currentFrame == inFrameLimit)
-        {
-            inFrameLimit += jumpFrame;
-            inAnimState += jumpState;
-        }
-        if (i < inAnimState && i < cast(u16, circles.size()))
-        {
-            DrawCircle(cast(i32, circles[i].x), cast(i32, circles[i].y), 25.f, color);
-        }
+        --resolution.cooldownFrames;
+        return false;
     }
-    if (inFrameLimit > resetFrame)
-        inFrameLimit = jumpFrame;
+    bool const isTopLevel = (resolution.level + 1) == resolution.scales.size();
+    if (resolution.averageSeconds > resolution.budgetSeconds * 1.15f)
+    {
+        resolution.stableFrames = 0;
+        if (resolution.level == 0)
+            return false;
+        --resolution.level;
+        resolution.probeFrames = std::min(resolution.probeFrames * 2,
+                                          cast(u32, 64.f / resolution.budgetSeconds));
+    }
+    else if (isTopLevel || ++resolution.stableFrames < resolution.probeFrames)
+        return false;
+    else
+    {
+        ++resolution.level;
+        resolution.stableFrames = 0;
+    }
+    resolution.averageSeconds = resolution.budgetSeconds;
+    resolution.cooldownFrames = cast(u32, .5f / resolution.budgetSeconds);
+    return true;
+}
+
+[[nodiscard]] [[maybe_unused]]
+inline auto renderScale(DynamicResolution const & resolution) noexcept -> f32
+{
+    return resolution.scales[resolution.level];
+}
+
+/*
+ *@Goal: render target of the current level (loaded on the first use)
+ */
+[[nodiscard]] [[maybe_unused]]
+auto renderTarget(DynamicResolution & resolution) -> RenderTexture2D const &
+{
+    RenderTexture2D & target = resolution.targets[resolution.level];
+    if (target.id == 0)
+    {
+        f32 const scale = renderScale(resolution);
+        target          = LoadRenderTexture(cast(i32, cast(f32, resolution.width) * scale),
+                                   cast(i32, cast(f32, resolution.height) * scale));
+        // not an integer scale => bilinear upscale
+        SetTextureFilter(target.texture, TEXTURE_FILTER_BILINEAR);
+    }
+    return target;
+}
+
+// order of the layers in the sort key (lower is drawn first)
+enum class RenderLayer : u8
+{
+    background = 0,
+    cell,
+    grid,
+    effect,
+    ui
+};
+
+/*
+ *@Goal: 64 bit sort key => sorted by layer then depth, shader and texture
+ *@Note: bits: [56,64) layer | [40,56) depth | [20,40) shader | [0,20) texture
+ *@Note: same layer and depth => same state is drawn together (less flushes)
+ */
+[[nodiscard]] [[maybe_unused]]
+constexpr auto makeSortKey(RenderLayer const layer,
+                           u32 const         shaderID,
+                           u32 const         textureID,
+                           u32 const         depth) noexcept -> u64
+{
+    return (cast(u64, layer) << 56) | (cast(u64, depth & 0xFFFF) << 40) |
+           (cast(u64, shaderID & 0xFFFFF) << 20) | cast(u64, textureID & 0xFFFFF);
 }
 
+/*
+ *@Goal: one textured quad (like DrawTexturePro without rotation)
+ */
+struct DrawCommand
+{
+    u64                key;
+    Shader             shader;
+    u32                textureID;
+    Rectangle          dest;
+    Rectangle          uv;  // 0 to 1
+    Color              color;
+    std::array<f32, 4> custom;
+};
 
-}  // namespace RA_Anim
-namespace RA_UI
+// what submitCommands did in one call
+struct RenderStats
 {
+    u32 commandCount {0};
+    u32 drawCalls {0};
+    u32 shaderChanges {0};
+    u32 textureChanges {0};
+};
 
-// entt that show as a ui element
-struct UIEntity
+// draw that is not a quad of the batch (labels, shapes, particles, ...)
+using DrawFn = std::function<void()>;
+
+/*
+ *@Goal: draw commands of a frame, sorted and drawn together at submit
+ *@Note: memory is kept between frames (clear, not free)
+ *@Note: draws are sorted with the quads (same key) and run at their place
+ */
+struct CommandQueue
 {
-    enum Type
+    struct SortItem
     {
-        PlaceHolder,   // empty layout with chileds?
-        spalshScreen,  // layout with image and childes?
-        Lable,
-        Button,
-        RoundButton,
-        ProgressBar
+        u64  key;
+        u32  index;
+        bool isDraw;  // index of draws (not commands)
     };
-    // default initilize to -1 => invalid index
-    i32 id {-1};
-    i32 parent {-1};
-    i32 child {-1};
-    // event dispatch
-    bool canClick {false};
-    i32  onClickID {-1};     // clickable
-    i32  onHoverInID {-1};   // everything
-    i32  onHoverOutID {-1};  // everything
-    i32  onStart {-1};       // progressBar
-    i32  onCompleted {-1};   // progressBar
-    // layout
-    Rectangle layoutRect {};
-    Color     backgroundColor {RED};
-    f32       rotation {};
-    bool      layoutHidden {false};
-    // text lable
-    i64       textID {-1};
-    Rectangle txtRect {};
-    f32       txtRotation {};
-    Color     txtColor {BLUE};
-    i32       fontID {-1};
-    f32       fontSize {};
-    f32       fontSpacing {};
-    bool      txtHidden {false};
-    // Round Btn
-    f32   borderRoundness {};
-    f32   lineThickness {};
-    Color borderColor {WHITE};
-    bool  btnHidden {false};
-    // icon
-    i32       imageID {-1};
-    Rectangle imgRect {};
-    f32       imgRotation {};
-    Color     imgColor {GREEN};
-    bool      imgHidden {false};
-    // sound fx
-    i32 sfxID {-1};
-    // shader
-    i32   shaderID {-1};
-    Color shaderColor {WHITE};
+
+    std::vector<DrawCommand> commands;
+    std::vector<DrawFn>      draws;
+    std::vector<u64>         drawKeys;
+    std::vector<SortItem>    items;
+    std::vector<SortItem>    scratch;
 };
 
-struct UILable
+[[maybe_unused]]
+inline auto pushCommand(CommandQueue &             queue,
+                        RenderLayer const          layer,
+                        u32 const                  depth,
+                        Shader const &             shader,
+                        u32 const                  textureID,
+                        Rectangle const &          dest,
+                        Rectangle const &          uv,
+                        Color const                color,
+                        std::array<f32, 4> const & custom = {}) -> void
 {
-    Vector2 position;
-    Color   textColor;
-
-    // *index of this item in owner array
-    // *index start from 0
-    // *(index < 0) means not init
-    u32 const fontIndx;
-    // lable allways has a text
-    // an indexid to hash table
-    u64 const textIndx;
+    queue.commands.push_back(DrawCommand {
+        .key       = makeSortKey(layer, shader.id, textureID, depth),
+        .shader    = shader,
+        .textureID = textureID,
+        .dest      = dest,
+        .uv        = uv,
+        .color     = color,
+        .custom    = custom});
+}
 
-    f32     fontSize;
-    f32     fontSpacing;
-    Vector2 textSize;
-    // Shader shader;
+/*
+ *@Goal: a draw that is not a quad (text, shapes, particle batches, ...)
+ *@Note: it runs at submit in the order of (layer, depth) and push order for
+ * the same key => state that change after the push should be captured by value
+ */
+[[maybe_unused]]
+inline auto pushDraw(CommandQueue &    queue,
+                     RenderLayer const layer,
+                     u32 const         depth,
+                     DrawFn            draw) -> void
+{
+    queue.drawKeys.push_back(makeSortKey(layer, 0, 0, depth));
+    queue.draws.push_back(std::move(draw));
+}
 
-    // private:
+/*
+ *@Goal: current frame of the animation as a quad of the default shader
+ *@Note: same as RA_Anim::renderAnim but ordered by layer and depth
+ */
+[[maybe_unused]]
+auto pushAnim(CommandQueue &            queue,
+              RA_Anim::AnimData const & data,
+              Vector2 const &           pos,
+              RenderLayer const         layer,
+              u32 const                 depth,
+              Color const               tint = WHITE) -> void
+{
+    f32 const width  = cast(f32, data.textureAnim.width);
+    f32 const height = cast(f32, data.textureAnim.height);
+    pushCommand(queue,
+                layer,
+                depth,
+                defaultShader(),
+                data.textureAnim.id,
+                Rectangle {pos.x, pos.y, std::abs(data.rect.width), std::abs(data.rect.height)},
+                Rectangle {.x      = data.rect.x / width,
+                           .y      = data.rect.y / height,
+                           .width  = data.rect.width / width,
+                           .height = data.rect.height / height},
+                tint);
+}
 
-    // *index of this item in owner array
-    // *index start from 0
-    // *(index < 0) means not init
-    std::size_t const id;
-    // *index of this item in owner array
-    // *index start from 0
-    // *(index < 0) means not init
-    i32 const parentInxd;
-    bool      isHidden {false};
+/*
+ *@Goal: circles, capsules and rounded rects as one quad each of the shape
+ * shader (sdf in the fragment shader) => every shape of a run is one draw call
+ *@Note: Shape.fs is not there or the batch has no vao (shape data is per
+ * vertex) => raylib shapes
+ */
+struct ShapeRenderer
+{
+    Shader         shader;
+    ShaderUniforms uniforms;
+    u32            textureID;  // raylib white texture
+    bool           isBatched;  // false => raylib shapes
+    f32            pixelScale {1.f};
 };
 
-struct UIRouondLayout
+/*
+ *@Note: batch is the one that submit the shapes (commands of the queue)
+ */
+[[nodiscard]] [[maybe_unused]]
+auto makeShapeRenderer(RA_Shader::ShaderCache & shaderCache, QuadBatch const & batch)
+    -> ShapeRenderer
 {
-    Rectangle rect;
-    f32       borderRoundness;
-    f32       lineThickness;
-    Color     borderColor;
-
+    Shader const  shader = RA_Shader::loadShader(shaderCache, "Shape.vs"sv, "Shape.fs"sv);
+    ShapeRenderer renderer {.shader    = shader,
+                            .uniforms  = makeShaderUniforms(shader, "shape"sv),
+                            .textureID = rlGetTextureIdDefault(),
+                            .isBatched = shader.id != rlGetShaderIdDefault() &&
+                                         batch.vaoID != 0};
+    addUniform(renderer.uniforms, "iPixelScale"sv, std::span {&renderer.pixelScale, 1});
+    return renderer;
+}
 
-    // private:
-    // *index of this item in owner array
-    // *index start from 0
-    // *(index < 0) means not init
-    std::size_t const id;
-    bool              isHidden {false};
-};
+[[maybe_unused]]
+auto unloadShapeRenderer(ShapeRenderer & renderer) noexcept -> void
+{
+    UnloadShader(renderer.shader);
+    renderer.shader = Shader {};
+}
 
-struct UIButton
+/*
+ *@Goal: pixels of the target per layout unit of the next shapes (1 pixel aa)
+ *@Warning: one scale per submit (it is a uniform of the whole batch)
+ */
+[[maybe_unused]]
+inline auto setShapePixelScale(ShapeRenderer & renderer, f32 const pixelScale) -> void
 {
-    // *index of this item in owner array
-    // *index start from 0
-    // *(index < 0) means not init
-    std::size_t const id;
-    i32 const         layoutIndx;
-    i32 const         lableIndx;
-    // i32 const iconIndx;
-    bool isHidden {false};
-    // sound
-    // shader
-};
+    renderer.pixelScale = pixelScale;
+    setUniform(renderer.uniforms, "iPixelScale"sv, pixelScale);
+    uploadUniforms(renderer.uniforms);
+}
 
-// TODO: Optimization
-// TODO: use struct of array and optimize lable and btn based on static or changable
-// TODO: render once on texture and use it for draw on thefront of all elemnts
-std::vector<UIRouondLayout> layoutArray {};
-std::vector<str>            lablesTextArray {};
-std::vector<UILable>        lablesArray {};
-// std::vector<UIicon>         iconsArray;
-std::vector<UIButton> buttonsArray {};
-std::vector<Font>     fontsArray {};
-#define REQUIREDELEMENTS 10
+/*
+ *@Goal: one quad of the shape shader (bounds + 1 pixel for anti aliasing)
+ *@Note: origin is (0, 0) of the shape space in the fragment shader
+ *@Warning: internall function usage for pushCapsule and pushRoundedRect
+ */
+[[maybe_unused]]
+inline auto pushShape(CommandQueue &             queue,
+                      ShapeRenderer const &      renderer,
+                      RenderLayer const          layer,
+                      u32 const                  depth,
+                      Rectangle const &          bounds,
+                      Vector2 const &            origin,
+                      Color const                color,
+                      std::array<f32, 4> const & shape) -> void
+{
+    f32 const       margin = 1.f / renderer.pixelScale;
+    Rectangle const dest {.x      = bounds.x - margin,
+                          .y      = bounds.y - margin,
+                          .width  = bounds.width + (margin * 2.f),
+                          .height = bounds.height + (margin * 2.f)};
+    pushCommand(queue,
+                layer,
+                depth,
+                renderer.shader,
+                renderer.textureID,
+                dest,
+                Rectangle {dest.x - origin.x, dest.y - origin.y, dest.width, dest.height},
+                color,
+                shape);
+}
 
-auto initUI() -> void
+/*
+ *@Goal: line with round caps (circle if start and end are the same)
+ */
+[[maybe_unused]]
+auto pushCapsule(CommandQueue &        queue,
+                 ShapeRenderer const & renderer,
+                 RenderLayer const     layer,
+                 u32 const             depth,
+                 Vector2 const &       start,
+                 Vector2 const &       end,
+                 f32 const             radius,
+                 Color const           color) -> void
 {
-    layoutArray.reserve(REQUIREDELEMENTS);
-    lablesTextArray.reserve(REQUIREDELEMENTS);
-    lablesArray.reserve(REQUIREDELEMENTS);
-    buttonsArray.reserve(REQUIREDELEMENTS);
-    fontsArray.reserve(REQUIREDELEMENTS);
+    if (!renderer.isBatched)
+    {
+        pushDraw(queue,
+                 layer,
+                 depth,
+                 [start, end, radius, color]()
+                 {
+                     DrawLineEx(start, end, radius * 2.f, color);
+                     DrawCircleV(start, radius, color);
+                     DrawCircleV(end, radius, color);
+                 });
+        return;
+    }
+    f32 const       left = std::min(start.x, end.x);
+    f32 const       top  = std::min(start.y, end.y);
+    Rectangle const bounds {.x      = left - radius,
+                            .y      = top - radius,
+                            .width  = std::max(start.x, end.x) - left + (radius * 2.f),
+                            .height = std::max(start.y, end.y) - top + (radius * 2.f)};
+    pushShape(queue,
+              renderer,
+              layer,
+              depth,
+              bounds,
+              start,
+              color,
+              {1.f, radius, end.x - start.x, end.y - start.y});
 }
-auto cleanUI() -> bool
+
+[[maybe_unused]]
+inline auto pushCircle(CommandQueue &        queue,
+                       ShapeRenderer const & renderer,
+                       RenderLayer const     layer,
+                       u32 const             depth,
+                       Vector2 const &       center,
+                       f32 const             radius,
+                       Color const           color) -> void
 {
-    // if (layoutArray.empty() || lablesTextArray.empty() || lablesArray.empty() ||
-    //     buttonsArray.empty() || fontsArray.empty())
-    //     return false;
-    layoutArray.clear();
-    lablesTextArray.clear();
-    lablesArray.clear();
-    buttonsArray.clear();
-    fontsArray.clear();
+    pushCapsule(queue, renderer, layer, depth, center, center, radius, color);
 }
 
-auto getFontID(Font const & font) -> u32
+/*
+ *@Goal: filled (thickness 0) or outlined rounded rect
+ *@Note: outline is out of the rect like DrawRectangleRoundedLinesEx
+ */
+[[maybe_unused]]
+auto pushRoundedRect(CommandQueue &        queue,
+                     ShapeRenderer const & renderer,
+                     RenderLayer const     layer,
+                     u32 const             depth,
+                     Rectangle const &     rect,
+                     f32 const             radius,
+                     f32 const             thickness,
+                     Color const           color) -> void
 {
-    static u32 fontID {0};
-    fontsArray.emplace_back(font);
-    return fontID++;
+    Vector2 const halfSize {rect.width * .5f, rect.height * .5f};
+    f32 const     clampedRadius = std::clamp(radius, 0.f, std::min(halfSize.x, halfSize.y));
+    if (!renderer.isBatched)
+    {
+        pushDraw(queue,
+                 layer,
+                 depth,
+                 [rect, clampedRadius, thickness, color]()
+                 {
+                     f32 const roundness = clampedRadius /
+                                           std::max(std::min(rect.width, rect.height) * .5f,
+                                                    1.f);
+                     if (thickness > 0.f)
+                         DrawRectangleRoundedLinesEx(rect, roundness, 8, thickness, color);
+                     else
+                         DrawRectangleRounded(rect, roundness, 8, color);
+                 });
+        return;
+    }
+    Rectangle const bounds {.x      = rect.x - thickness,
+                            .y      = rect.y - thickness,
+                            .width  = rect.width + (thickness * 2.f),
+                            .height = rect.height + (thickness * 2.f)};
+    pushShape(queue,
+              renderer,
+              layer,
+              depth,
+              bounds,
+              Vector2 {rect.x + halfSize.x, rect.y + halfSize.y},
+              color,
+              {-(thickness + 1.f), clampedRadius, halfSize.x, halfSize.y});
 }
 
-auto initRoundButton(i32 const  layoutIndx,
-                     i32 const  lableIndx /*, i32 const iconIndx */,
-                     bool const isHidden = false) -> u32
+/*
+ *@Goal: occupied cells as commands of the merged cell shader
+ *@Note: owner, age and size are per vertex (vertexTexCoord2) => every cell of
+ * the board is in the same run (one draw call)
+ *@Note: cells are drawn on the half size render target (y is flipped for glsl)
+ */
+[[maybe_unused]]
+auto pushCells(CommandQueue &                         queue,
+               u64 const                              occupied,
+               std::span<PlayerShapeInfo const> const cells,
+               Shader const &                         shader,
+               u32 const                              textureID,
+               f64 const                              now) -> void
 {
-    UIButton const btn {.id         = buttonsArray.size(),
-                        .layoutIndx = layoutIndx,
-                        .lableIndx  = lableIndx,
-                        .isHidden   = isHidden};
-    // TODO: add icon
-    //  .iconIndx   = iconIndx};
-    buttonsArray.emplace_back(btn);
-    return btn.id;
+    for (u64 bits = occupied; bits != 0; bits &= bits - 1)
+    {
+        auto const              cell  = cast(u32, std::countr_zero(bits));
+        PlayerShapeInfo const & shape = cells[cell];
+        Rectangle const         dest {.x = (shape.rect.x * .5f) - (shape.rect.width * 0.25f),
+                                      .y = (gHeight * .5f) -
+                                           ((shape.rect.y * .5f) - (shape.rect.height * .25f)) -
+                                           (shape.rect.height),
+                                      .width  = shape.rect.width,
+                                      .height = shape.rect.height};
+        pushCommand(queue,
+                    RenderLayer::cell,
+                    cell,
+                    shader,
+                    textureID,
+                    dest,
+                    Rectangle {0.f, 0.f, 1.f, 1.f},
+                    WHITE,
+                    {cast(f32, shape.id), cast(f32, now - shape.placedTime), dest.width, 0.f});
+    }
 }
 
-auto initRoundLayout(Rectangle const & rect,
-                     f32 const         borderRoundness,
-                     f32 const         lineThickness,
-                     Color const &     borderColor,
-                     bool const        isHidden = false) -> u32
+/*
+ *@Goal: stable lsd radix sort on the keys (8 bits per pass)
+ *@Note: a pass is skipped when every key has the same byte there (most of
+ * the key is the same in a frame => usually 2 or 3 passes)
+ */
+[[maybe_unused]]
+auto radixSort(std::vector<CommandQueue::SortItem> & items,
+               std::vector<CommandQueue::SortItem> & scratch) -> void
 {
-    UIRouondLayout const layout {.rect            = rect,
-                                 .borderRoundness = borderRoundness,
-                                 .lineThickness   = lineThickness,
-                                 .borderColor     = borderColor,
-                                 .id              = layoutArray.size(),
-                                 .isHidden        = isHidden};
-    layoutArray.emplace_back(layout);
-    return layout.id;
+    if (items.size() < 2)
+        return;
+    scratch.resize(items.size());
+    for (u32 shift = 0; shift < 64; shift += 8)
+    {
+        std::array<u32, 256> offsets {};
+        for (auto const & item : items)
+            ++offsets[(item.key >> shift) & 0xFF];
+        if (offsets[(items.front().key >> shift) & 0xFF] == items.size())
+            continue;
+        // count => first slot of each byte value
+        u32 sum {0};
+        for (auto & offset : offsets)
+        {
+            u32 const count = offset;
+            offset          = sum;
+            sum += count;
+        }
+        for (auto const & item : items)
+            scratch[offsets[(item.key >> shift) & 0xFF]++] = item;
+        items.swap(scratch);
+    }
 }
 
-// position 0,0 is centerned by default
-auto makeLable(char const*     text,
-               Color const &   txtColor,
-               u32 const       fontIndx         = 0,
-               u16 const       fontSize         = 20,
-               Vector2 const & position         = {0, 0},
-               f32 const       fontSpace        = 2.f,
-               bool const      isHidden         = false,
-               i32 const       parentLayoutIndx = -1) -> u32
+/*
+ *@Goal: sort the commands and draw them as runs of the same shader+texture
+ *@Note: each run bind its shader once and is one draw call (more if the run
+ * is bigger than the batch)
+ *@Note: a draw of pushDraw end the current run (state is set again after it)
+ */
+[[maybe_unused]]
+auto submitCommands(CommandQueue & queue, QuadBatch & batch) -> RenderStats
 {
-    RA_Util::checkAtRuntime((fontSize <= 0), "font scale should not be zero");
-    RA_Util::checkAtRuntime((fontIndx < 0), "font index is not valid"sv);
-    Font const currentFont = fontsArray[cast(u32, fontIndx)];
-    f32 const currentFontSize = cast(f32, currentFont.baseSize) * (fontSize / 100.f);
-    lablesTextArray.emplace_back(text);
+    PROFILE();
+    RenderStats stats {.commandCount = cast(u32, queue.commands.size() + queue.draws.size())};
+    queue.items.clear();
+    for (u32 i = 0; i < queue.commands.size(); ++i)
+        queue.items.push_back(CommandQueue::SortItem {queue.commands[i].key, i, false});
+    for (u32 i = 0; i < queue.draws.size(); ++i)
+        queue.items.push_back(CommandQueue::SortItem {queue.drawKeys[i], i, true});
+    radixSort(queue.items, queue.scratch);
+
+    Shader     runShader {};
+    u32        runTexture {0};
+    bool       hasRun {false};
+    auto const flush = [&]()
+    {
+        if (batch.quadCount == 0)
+            return;
+        flushQuadBatch(batch, runShader, runTexture);
+        ++stats.drawCalls;
+    };
+    for (auto const & item : queue.items)
+    {
+        if (item.isDraw)
+        {
+            // quads before it should be on the screen first
+            flush();
+            hasRun = false;
+            queue.draws[item.index]();
+            continue;
+        }
+        DrawCommand const & command = queue.commands[item.index];
+        bool const isNewShader      = !hasRun || command.shader.id != runShader.id;
+        bool const isNewTexture     = !hasRun || command.textureID != runTexture;
+        if (isNewShader || isNewTexture)
+        {
+            flush();
+            stats.shaderChanges += isNewShader ? 1 : 0;
+            stats.textureChanges += isNewTexture ? 1 : 0;
+            runShader  = command.shader;
+            runTexture = command.textureID;
+            hasRun     = true;
+        }
+        if (!pushQuad(batch, command.dest, command.uv, command.color, command.custom))
+        {
+            flush();
+            (void)pushQuad(batch, command.dest, command.uv, command.color, command.custom);
+        }
+    }
+    flush();
+    queue.commands.clear();
+    queue.draws.clear();
+    queue.drawKeys.clear();
+    return stats;
+}
+}  // namespace RA_Render
+
+// sse2 is the base line of x64 (arm/android use the scalar loops)
+#if defined(__SSE2__) && (defined(__x86_64__) || defined(__i386__))
+#define PARTICLE_SSE 1
+#else
+#define PARTICLE_SSE 0
+#endif
 
-    UILable lable {.position    = position,
-                   .textColor   = txtColor,
-                   .fontIndx    = fontIndx,
-                   .textIndx    = (lablesTextArray.size() - 1),
-                   .fontSize    = currentFontSize,
-                   .fontSpacing = fontSpace,
-                   .textSize = MeasureTextEx(currentFont, text, currentFontSize, fontSpace),
-                   .id         = lablesArray.size(),
-                   .parentInxd = parentLayoutIndx,
-                   .isHidden   = isHidden};
+namespace RA_Particle
+{
 
-    if (parentLayoutIndx >= 0)
+/*
+ *@Goal: box2d task interface on top of the project job system
+ *@Note: box2d enqueue some tasks in a step and finish all of them in the same
+ * step => groups are reused after each step
+ */
+struct Box2dTasks
+{
+    RA_Util::JobSystem*                           jobs {nullptr};
+    std::array<RA_Util::JobSystem::TaskGroup, 64> groups {};
+    u32                                           count {0};
+};
+
+[[maybe_unused]]
+auto enqueueBox2dTask(b2TaskCallback* const task,
+                      i32 const             itemCount,
+                      i32 const             minRange,
+                      void* const           taskContext,
+                      void* const           userContext) -> void*
+{
+    auto & tasks = *static_cast<Box2dTasks*>(userContext);
+    if (tasks.count == tasks.groups.size())
     {
-        Rectangle const parentLayout = layoutArray[cast(u32, parentLayoutIndx)].rect;
-        lable.position.x = parentLayout.x + (parentLayout.width / 2.f) -
-                           lable.textSize.x / 2.f;
-        lable.position.y = parentLayout.y + (parentLayout.height / 2.f) -
-                           lable.textSize.y / 2;
+        // out of groups => run it now (nullptr tell box2d it is finished)
+        task(0, itemCount, 0, taskContext);
+        return nullptr;
     }
-
-    lablesArray.emplace_back(lable);
-    return lable.id;
+    auto & group = tasks.groups[tasks.count++];
+    tasks.jobs->parallelFor(task, itemCount, minRange, taskContext, group);
+    return &group;
 }
-auto updateLable(u32 const       lableID,
-                 char const*     text,
-                 Color const &   txtColor,
-                 u16 const       fontSize = 20,
-                 bool const      isHidden = false,
-                 Vector2 const & position = {0, 0})
+
+[[maybe_unused]]
+auto finishBox2dTask(void* const userTask, void* const userContext) -> void
 {
-    lablesTextArray[lablesArray[lableID].textIndx] = text;
-    lablesArray[lableID].textColor                 = txtColor;
-    lablesArray[lableID].fontSize                  = fontSize;
-    lablesArray[lableID].position                  = position;
-    lablesArray[lableID].isHidden                  = isHidden;
+    auto const & tasks = *static_cast<Box2dTasks const*>(userContext);
+    tasks.jobs->wait(*static_cast<RA_Util::JobSystem::TaskGroup const*>(userTask));
 }
-auto drawRoundLayout(i32 const layoutID) -> void
-{
-    RA_Util::checkAtRuntime((layoutID < 0), "layout id is invalid");
 
-    auto const lay = layoutArray[cast(u32, layoutID)];
-    if (lay.isHidden)
-        return;
-    DrawRectangleRoundedLinesEx(lay.rect,
-                                lay.borderRoundness,
-                                1,
-                                lay.lineThickness,
-                                lay.borderColor);
+[[nodiscard]] [[maybe_unused]]
+auto initWorldOfBox2d(Box2dTasks & tasks) noexcept -> b2WorldId
+{
+    b2WorldDef   worldDef    = {b2DefaultWorldDef()};
+    b2Vec2 const gravity     = {0.f, -10.f};
+    worldDef.gravity         = gravity;
+    worldDef.enableSleep     = true;
+    worldDef.workerCount     = cast(i32, tasks.jobs->workerCount());
+    worldDef.enqueueTask     = &enqueueBox2dTask;
+    worldDef.finishTask      = &finishBox2dTask;
+    worldDef.userTaskContext = &tasks;
+    b2WorldId worldID        = {b2CreateWorld(&worldDef)};
+    return worldID;
 }
 
-// font scale should be bigger than 0.0
-auto drawLable(u32 const lableID) -> void
+/*
+ *@Goal: one physics tick (solver islands run on the job system)
+ *@Note: box2d timings of the step are written as profiler counters
+ */
+[[maybe_unused]]
+auto stepWorld(b2WorldId const worldID,
+               f32 const       timeStep,
+               i32 const       subStepCount,
+               Box2dTasks &    tasks) noexcept -> void
 {
-    RA_Util::checkAtRuntime((lableID < 0), "lable id is invalid");
-    UILable const & lable       = lablesArray[lableID];
-    Font const &    currentFont = fontsArray[lable.fontIndx];
-    char const*     text        = lablesTextArray[lable.textIndx].c_str();
-    if (text == nullptr || lable.fontSize == 0 || lable.isHidden)
-        return;
+    {
+        PROFILE_SCOPE("b2World_Step");
+        b2World_Step(worldID, timeStep, subStepCount);
+    }
+    tasks.count = 0;
 
-    DrawTextEx(currentFont,
-               text,
-               lable.position,
-               lable.fontSize,
-               lable.fontSpacing,
-               lable.textColor);
+    [[maybe_unused]] b2Profile const profile = b2World_GetProfile(worldID);
+    PROFILE_COUNTER("box2d step ms", profile.step);
+    PROFILE_COUNTER("box2d collide ms", profile.collide);
+    PROFILE_COUNTER("box2d solve ms", profile.solve);
 }
 
-// auto drawIcon(u32 const iconId)
-// {
-// }
-
-auto drawRoundButton(u32 const btnID)
+[[nodiscard]] [[maybe_unused]]
+auto creatDynamicBody(Particle const & pr, b2WorldId const & worldID) noexcept
+    -> b2BodyId
 {
-    RA_Util::checkAtRuntime((btnID < 0), "btn id is invalid");
-    auto const currentBtn = buttonsArray[btnID];
-    if (currentBtn.isHidden)
-        return;
-    if (currentBtn.layoutIndx >= 0)
-        drawRoundLayout(currentBtn.layoutIndx);
-    // if (currentBtn.iconIndx >= 0)
-    //     drawIcon(currentBtn.iconIndx);
-    if (currentBtn.lableIndx >= 0)
-        drawLable(currentBtn.lableIndx);
+    // Create a dynamic box (box2d-related)
+    b2BodyDef boxDef          = {b2DefaultBodyDef()};
+    boxDef.isEnabled          = false;
+    boxDef.enableSleep        = true;
+    boxDef.position           = b2Vec2 {-pr.rect.x, -pr.rect.y};
+    boxDef.type               = b2_dynamicBody;
+    boxDef.rotation           = b2MakeRot(30.f * DEG2RAD);
+    b2BodyId const  boxBodyId = {b2CreateBody(worldID, &boxDef)};
+    b2Polygon const boxShape  = {
+        b2MakeBox(pr.rect.width / 2.f, pr.rect.height / 2.f)};
+    b2ShapeDef boxShapeDef          = {b2DefaultShapeDef()};
+    boxShapeDef.density             = 0.5f;
+    boxShapeDef.filter.categoryBits = 0x0002;
+    boxShapeDef.filter.maskBits     = 0xFFFF ^ 0x0002;
+    b2CreatePolygonShape(boxBodyId, &boxShapeDef, &boxShape);
+    return boxBodyId;
+}
+[[maybe_unused]]
+auto impulseParticle(Particle const & pr) noexcept -> void
+{
+    f32 force = 0.f;
+    if (cast(u16, gRandom.getRandom()) % 2 == 0)
+        force = -(800 + gRandom.getRandom());
+    else
+        force = 1600 + gRandom.getRandom();
+    b2Body_Enable(pr.bodyID);
+    b2Body_ApplyForceToCenter(pr.bodyID,
+                              b2Vec2 {.x = force * gRandom.getRandom(),
+                                      .y = force * gRandom.getRandom()},
+                              true);
 }
 
-auto makeRoundButton(Rectangle const & rect,
-                     f32 const         borderRoundness,
-                     f32 const         borderThickness,
-                     Color const &     borderColor,
-                     char const*       text,
-                     Color const &     txtColor,
-                     u16 const         fontSize,
-                     bool const        isHidden,
-                     u32 const         fontIndx = 0) -> u32
+/*
+ *@Goal: move the body back on top of the screen (disabled)
+ */
+[[maybe_unused]]
+auto resetParticle(Particle & pr) noexcept -> void
 {
-    u32 const layid = initRoundLayout(rect,
-                                      borderRoundness,
-                                      borderThickness,
-                                      borderColor,
-                                      isHidden);
-    // RA_Util::checkAtRuntime((layid < 0), "layout id is negative");
-    u32 const lblid = makeLable(text, txtColor, fontIndx, fontSize, Vector2 {}, 2.f, isHidden, layid);
-    // RA_Util::checkAtRuntime((lblid < 0), "lable id is negative");
-    u32 const btnid = initRoundButton(layid,
-                                      lblid
-                                      /* , i32 const iconIndx*/,
-                                      isHidden);
-    // RA_Util::checkAtRuntime((btnid < 0), "btn id is negative");
-    return btnid;
+    b2Vec2 const boxPos {.x = -1.f * gRandom.getRandom(), .y = (gHeight / 3.f)};
+    b2Body_SetTransform(pr.bodyID, boxPos, b2MakeRot(0.f));
+    b2Body_Disable(pr.bodyID);
+    // teleport => no interpolation from the old position
+    pr.current  = Vector2 {-boxPos.x, -boxPos.y};
+    pr.previous = pr.current;
+}
+/*
+ *@Goal: read the body positions after a physics tick (box2d y is up)
+ */
+[[maybe_unused]]
+auto syncParticles(std::span<Particle> const & particles) noexcept -> void
+{
+    for (auto & pr : particles)
+    {
+        b2Vec2 const boxPos {b2Body_GetPosition(pr.bodyID)};
+        pr.previous = pr.current;
+        pr.current  = Vector2 {-boxPos.x, -boxPos.y};
+    }
 }
 
-auto getBtnRect(u32 const btnID) -> Rectangle
+/*
+ *@Goal: box2d bodies of the particles are created on demand and reused
+ *@Note: bodies are [0, activeCount) simulated | [activeCount, drawCount) asleep
+ * (settled but still drawn) | [drawCount, size) disabled and free
+ *@Note: activeCap limit the simulated bodies, maxBodies limit the created ones
+ */
+struct BodyPool
 {
-    return layoutArray[cast(u32, buttonsArray[btnID].layoutIndx)].rect;
+    std::vector<Particle> bodies {};
+    b2WorldId             worldID {};
+    u32                   activeCount {0};
+    u32                   drawCount {0};
+    u32                   activeCap {0};
+    u32                   batchSize {0};
+    u32                   maxBodies {0};
+};
+
+/*
+ *@Goal: empty pool (no body is created till the first spawn)
+ */
+[[nodiscard]] [[maybe_unused]]
+auto makeBodyPool(b2WorldId const worldID,
+                  u32 const       activeCap,
+                  u32 const       batchSize,
+                  u32 const       maxBodies) -> BodyPool
+{
+    BodyPool pool {.worldID   = worldID,
+                   .activeCap = std::min(activeCap, maxBodies),
+                   .batchSize = std::max(batchSize, 1U),
+                   .maxBodies = maxBodies};
+    pool.bodies.reserve(maxBodies);
+    return pool;
 }
-}  // namespace RA_UI
 
-struct PlayerShapeInfo
+/*
+ *@Goal: create the next batch of (disabled) bodies
+ *@Note: return false if the pool already has maxBodies
+ */
+[[nodiscard]] [[maybe_unused]]
+auto growBodyPool(BodyPool & pool) -> bool
 {
-    Rectangle rect;
-    Color     color;
-    u8        id;
+    PROFILE();
+    u32 const amount = std::min(pool.batchSize,
+                                pool.maxBodies - cast(u32, pool.bodies.size()));
+    for (u32 i = 0; i < amount; ++i)
+    {
+        Particle  pr {};
+        f32 const size = littleRandom.getRandom();
+        pr.rect        = Rectangle {.x      = gRandom.getRandom(),
+                                    .y      = (gHeight / -3.f),
+                                    .width  = size,
+                                    .height = size};
+        pr.bodyID      = creatDynamicBody(pr, pool.worldID);
+        pr.current     = Vector2 {pr.rect.x, pr.rect.y};
+        pr.previous    = pr.current;
+        pool.bodies.push_back(pr);
+    }
+    return amount != 0;
+}
 
-    PlayerShapeInfo(Rectangle const & r, Color const & c, u8 const i) :
-    rect {r},
-    color {c},
-    id {i}
+/*
+ *@Goal: throw free bodies (reused first, then created) from top of the screen
+ *@Note: return how many are spawned (less than amount if activeCap is reached)
+ *@Note: if the pool is full the resting bodies are reused
+ */
+[[maybe_unused]]
+auto spawnBodies(BodyPool & pool, u32 const amount) -> u32
+{
+    u32 spawned {0};
+    while (spawned < amount && pool.activeCount < pool.activeCap)
     {
+        if (pool.drawCount == pool.bodies.size() && !growBodyPool(pool))
+        {
+            if (pool.drawCount == pool.activeCount)
+                break;
+            --pool.drawCount;  // last resting body is free now
+        }
+        // first free <-> first resting => the free one is the next active
+        std::swap(pool.bodies[pool.drawCount], pool.bodies[pool.activeCount]);
+        Particle & pr = pool.bodies[pool.activeCount];
+        ++pool.activeCount;
+        ++pool.drawCount;
+        resetParticle(pr);
+        impulseParticle(pr);
+        ++spawned;
     }
+    return spawned;
+}
 
-    PlayerShapeInfo()  = default;
-    ~PlayerShapeInfo() = default;
-    auto operator=(PlayerShapeInfo const & rhs) -> PlayerShapeInfo &
+/*
+ *@Goal: resting bodies that box2d woke up (hit by a new one) are active again
+ *@Note: call it after a physics tick, before syncParticles and retireBodies
+ * => woken bodies are drawn where box2d moves them and can leave the boundry
+ */
+[[maybe_unused]]
+auto wakeRestingBodies(BodyPool & pool) noexcept -> void
+{
+    for (u32 i = pool.activeCount; i < pool.drawCount; ++i)
     {
-        if (this == &rhs)
-            return *this;
-        rect  = rhs.rect;
-        color = rhs.color;
-        id    = rhs.id;
-        return *this;
+        if (b2Body_IsAwake(pool.bodies[i].bodyID))
+            std::swap(pool.bodies[i], pool.bodies[pool.activeCount++]);
     }
-    [[maybe_unused]]
-    auto operator==(PlayerShapeInfo const & rhs) const noexcept -> bool
+}
+
+/*
+ *@Goal: take the bodies out of the simulation (after a physics tick)
+ *@Note: left the boundry => disabled and free | asleep => resting (still drawn)
+ */
+[[maybe_unused]]
+auto retireBodies(BodyPool & pool, Rectangle const & boundry) noexcept -> void
+{
+    u32 i {0};
+    while (i < pool.activeCount)
     {
-        return (rect.x == rhs.rect.x && rect.y == rhs.rect.y);
+        Particle & pr    = pool.bodies[i];
+        bool const isOut = RA_Util::isClippingForRender(pr.current, boundry);
+        if (!isOut && b2Body_IsAwake(pr.bodyID))
+        {
+            ++i;
+            continue;
+        }
+        pr.previous    = pr.current;
+        u32 const last = --pool.activeCount;
+        std::swap(pool.bodies[i], pool.bodies[last]);
+        if (isOut)
+        {
+            b2Body_Disable(pool.bodies[last].bodyID);
+            std::swap(pool.bodies[last], pool.bodies[--pool.drawCount]);
+        }
     }
-};
-// Define the operator== function outside the class
-struct Particle
+}
+
+/*
+ *@Goal: disable every body, all of them are free for the next spawn
+ */
+[[maybe_unused]]
+auto clearBodies(BodyPool & pool) noexcept -> void
 {
-    Rectangle rect;
-    b2BodyId  bodyID;
-};
-enum class GameState : u8
+    for (u32 i = 0; i < pool.drawCount; ++i)
+        b2Body_Disable(pool.bodies[i].bodyID);
+    pool.activeCount = 0;
+    pool.drawCount   = 0;
+}
+
+// bodies that box2d move each tick
+[[nodiscard]] [[maybe_unused]]
+auto activeBodies(BodyPool & pool) noexcept -> std::span<Particle>
 {
-    none = 0,
-    win,
-    tie,
-    end
-};
+    return {pool.bodies.data(), pool.activeCount};
+}
 
-// game glob vars
-i32                    gHeight {0};
-i32                    gWidth {0};
-u32                    winUIFramCounter {0};
-u32                    winFrameLimit {10};
-u32                    winAnimResetFrame {40};
-u8                     winAnimState {1};
-bool                   canReset {false};
-Vector2                uIPointAnimationWin {0.f, 0.f};
-Vector2                mousePos {0.f, 0.f};
-GameState              currentState {GameState::none};
-RA_Util::GRandom const gRandom(-1200.f, 1500.f);
-RA_Util::GRandom const littleRandom(5.f, 15.f);
-// constexpr u16 const    fps {60};
-constexpr u8 const row    = 3;
-constexpr u8 const column = 3;
-constexpr u8 const goal   = 3;
-struct Player
+// active and resting bodies
+[[nodiscard]] [[maybe_unused]]
+auto drawnBodies(BodyPool const & pool) noexcept -> std::span<Particle const>
+{
+    return {pool.bodies.data(), pool.drawCount};
+}
+
+/*
+ *@Goal: draw particles between previous and current tick (alpha is 0 to 1)
+ *@Note: source is the sprite rect in texture pixels (e.g. an atlas region)
+ */
+[[maybe_unused]]
+auto drawParticles(std::span<Particle const> const & particles,
+                   Texture2D const &                 texture,
+                   Rectangle const &                 source,
+                   Color                             color,
+                   f32 const                         alpha) noexcept -> void
+{
+    for (auto const & pr : particles)
+    {
+        f32 const scale = pr.rect.width / 10.f;
+        DrawTexturePro(texture,
+                       source,
+                       Rectangle {pr.previous.x + ((pr.current.x - pr.previous.x) * alpha),
+                                  pr.previous.y + ((pr.current.y - pr.previous.y) * alpha),
+                                  source.width * scale,
+                                  source.height * scale},
+                       Vector2 {},
+                       0.f,
+                       color);
+    }
+}
+
+/*
+ *@Goal: cosmetic particles (confetti) as SoA => no box2d body, no collision
+ *@Note: alive particles are [0, count) and dead ones are swapped to the end
+ *@Note: arrays are padded to 4 floats so the simd loop does not need a tail
+ */
+struct Emitter
 {
-    std::bitset<row * column> moves;
-    Color const               rectColor;
-    str const                 name;
-    i32 const                 id;
+    std::vector<f32> posX;
+    std::vector<f32> posY;
+    std::vector<f32> prevX;  // position at the previous tick (interpolation)
+    std::vector<f32> prevY;
+    std::vector<f32> velX;
+    std::vector<f32> velY;
+    std::vector<f32> life;  // seconds left
+    std::vector<f32> size;  // pixels
+    u32              count {0};
+    u32              capacity {0};
 };
-// clang-format off
-// win condition should check this table to state the winner
-// win table for 3x3
-inline static constexpr std::array<std::bitset<row*column>, 8> const winTable 
-{
-    0x007, 0x038,
-    0x049, 0x054,
-    0x092, 0x111, 
-    0x124, 0x1c0
-};
-// win table for 4x4
-// inline static constexpr std::array<std::bitset<row*column>, 10> const winTable 
-// {
-//     0b1111000000000000,0b0000111100000000,0b0000000011110000,0b0000000000001111,
-//     0b1000100010001000,0b0100010001000100,0b0010001000100010,0b0001000100010001,
-//     0b1000010000100001,0b0001001001001000
-// };
-// clang-format on
 
-
-namespace RA_Particle
+/*
+ *@Goal: where and how new particles are born (min/max are uniform random)
+ */
+struct EmitInfo
 {
+    Rectangle area;
+    Vector2   minVelocity;
+    Vector2   maxVelocity;
+    f32       minLife;
+    f32       maxLife;
+    f32       minSize;
+    f32       maxSize;
+};
+
+RA_Util::GRandom const unitRandom(0.f, 1.f);
 
 [[nodiscard]] [[maybe_unused]]
-auto initWorldOfBox2d() noexcept -> b2WorldId
+inline auto randomBetween(f32 const min, f32 const max) noexcept -> f32
 {
-    b2WorldDef   worldDef = {b2DefaultWorldDef()};
-    b2Vec2 const gravity  = {0.f, -10.f};
-    worldDef.gravity      = gravity;
-    b2WorldId worldID     = {b2CreateWorld(&worldDef)};
-    worldDef.enableSleep  = true;
-    return worldID;
+    return min + ((max - min) * unitRandom.getRandom());
 }
 
 [[nodiscard]] [[maybe_unused]]
-auto creatDynamicBody(Particle const & pr, b2WorldId const & worldID) noexcept
-    -> b2BodyId
+auto makeEmitter(u32 const capacity) -> Emitter
 {
-    // Create a dynamic box (box2d-related)
-    b2BodyDef boxDef          = {b2DefaultBodyDef()};
-    boxDef.isEnabled          = false;
-    boxDef.enableSleep        = true;
-    boxDef.position           = b2Vec2 {-pr.rect.x, -pr.rect.y};
-    boxDef.type               = b2_dynamicBody;
-    boxDef.rotation           = b2MakeRot(30.f * DEG2RAD);
-    b2BodyId const  boxBodyId = {b2CreateBody(worldID, &boxDef)};
-    b2Polygon const boxShape  = {
-        b2MakeBox(pr.rect.width / 2.f, pr.rect.height / 2.f)};
-    b2ShapeDef boxShapeDef          = {b2DefaultShapeDef()};
-    boxShapeDef.density             = 0.5f;
-    boxShapeDef.filter.categoryBits = 0x0002;
-    boxShapeDef.filter.maskBits     = 0xFFFF ^ 0x0002;
-    b2CreatePolygonShape(boxBodyId, &boxShapeDef, &boxShape);
-    return boxBodyId;
+    u32 const padded = (capacity + 3U) & ~3U;
+    Emitter   emitter {};
+    for (auto* const array : {&emitter.posX,
+                              &emitter.posY,
+                              &emitter.prevX,
+                              &emitter.prevY,
+                              &emitter.velX,
+                              &emitter.velY,
+                              &emitter.life,
+                              &emitter.size})
+        array->resize(padded, 0.f);
+    emitter.capacity = capacity;
+    return emitter;
 }
+
+/*
+ *@Goal: born new particles (as much as capacity let)
+ */
 [[maybe_unused]]
-auto impulseParticles(std::span<Particle> const & particles) noexcept -> void
+auto emitParticles(Emitter & emitter, u32 const amount, EmitInfo const & info) noexcept
+    -> void
 {
-    u16 i {};
-    for (auto const pr : particles)
+    u32 const end = std::min(emitter.capacity, emitter.count + amount);
+    for (u32 i = emitter.count; i < end; ++i)
     {
-        f32 force = 0.f;
-        if (i < (particles.size() / 2))
-            force = -(800 + gRandom.getRandom());
-        else
-            force = 1600 + gRandom.getRandom();
-        b2Body_Enable(pr.bodyID);
-        b2Body_ApplyForceToCenter(pr.bodyID,
-                                  b2Vec2 {.x = force * gRandom.getRandom(),
-                                          .y = force * gRandom.getRandom()},
-                                  true);
-        i++;
+        emitter.posX[i] = randomBetween(info.area.x, info.area.x + info.area.width);
+        emitter.posY[i] = randomBetween(info.area.y, info.area.y + info.area.height);
+        emitter.prevX[i] = emitter.posX[i];
+        emitter.prevY[i] = emitter.posY[i];
+        emitter.velX[i] = randomBetween(info.minVelocity.x, info.maxVelocity.x);
+        emitter.velY[i] = randomBetween(info.minVelocity.y, info.maxVelocity.y);
+        emitter.life[i] = randomBetween(info.minLife, info.maxLife);
+        emitter.size[i] = randomBetween(info.minSize, info.maxSize);
     }
+    emitter.count = end;
 }
 
 [[maybe_unused]]
-auto impulseParticle(Particle const & pr) noexcept -> void
+auto clearParticles(Emitter & emitter) noexcept -> void
 {
-    f32 force = 0.f;
-    if (cast(u16, gRandom.getRandom()) % 2 == 0)
-        force = -(800 + gRandom.getRandom());
-    else
-        force = 1600 + gRandom.getRandom();
-    b2Body_Enable(pr.bodyID);
-    b2Body_ApplyForceToCenter(pr.bodyID,
-                              b2Vec2 {.x = force * gRandom.getRandom(),
-                                      .y = force * gRandom.getRandom()},
-                              true);
+    emitter.count = 0;
 }
 
+/*
+ *@Goal: gravity + drag + move + age of the alive particles
+ *@Note: sse does 4 particles per step, scalar is the fallback (android/arm)
+ */
+[[maybe_unused]]
+auto integrateParticles(Emitter &     emitter,
+                        f32 const     dt,
+                        Vector2 const gravity,
+                        f32 const     drag) noexcept -> void
+{
+    f32 const damping = std::max(0.f, 1.f - (drag * dt));
+    u32       i {0};
+#if PARTICLE_SSE == 1
+    __m128 const stepVelX = _mm_set1_ps(gravity.x * dt);
+    __m128 const stepVelY = _mm_set1_ps(gravity.y * dt);
+    __m128 const damp     = _mm_set1_ps(damping);
+    __m128 const step     = _mm_set1_ps(dt);
+    // padding => reading the last (not full) 4 floats is safe
+    for (; i < emitter.count; i += 4)
+    {
+        __m128 velX       = _mm_loadu_ps(emitter.velX.data() + i);
+        __m128 velY       = _mm_loadu_ps(emitter.velY.data() + i);
+        __m128 const posX = _mm_loadu_ps(emitter.posX.data() + i);
+        __m128 const posY = _mm_loadu_ps(emitter.posY.data() + i);
+        velX              = _mm_mul_ps(_mm_add_ps(velX, stepVelX), damp);
+        velY              = _mm_mul_ps(_mm_add_ps(velY, stepVelY), damp);
+        _mm_storeu_ps(emitter.velX.data() + i, velX);
+        _mm_storeu_ps(emitter.velY.data() + i, velY);
+        _mm_storeu_ps(emitter.prevX.data() + i, posX);
+        _mm_storeu_ps(emitter.prevY.data() + i, posY);
+        _mm_storeu_ps(emitter.posX.data() + i, _mm_add_ps(posX, _mm_mul_ps(velX, step)));
+        _mm_storeu_ps(emitter.posY.data() + i, _mm_add_ps(posY, _mm_mul_ps(velY, step)));
+        _mm_storeu_ps(emitter.life.data() + i,
+                      _mm_sub_ps(_mm_loadu_ps(emitter.life.data() + i), step));
+    }
+#endif
+    for (; i < emitter.count; ++i)
+    {
+        emitter.velX[i] = (emitter.velX[i] + (gravity.x * dt)) * damping;
+        emitter.velY[i] = (emitter.velY[i] + (gravity.y * dt)) * damping;
+        emitter.prevX[i] = emitter.posX[i];
+        emitter.prevY[i] = emitter.posY[i];
+        emitter.posX[i] += emitter.velX[i] * dt;
+        emitter.posY[i] += emitter.velY[i] * dt;
+        emitter.life[i] -= dt;
+    }
+}
 
+/*
+ *@Goal: remove particles that are dead or out of the boundry
+ *@Note: swap with the last alive one => order is not stable (no need)
+ */
 [[maybe_unused]]
-auto resetParticles(std::span<Particle> const & particles) noexcept -> void
+auto killParticles(Emitter & emitter, Rectangle const & boundry) noexcept -> void
 {
-    for (auto const pr : particles)
+    u32 i {0};
+    while (i < emitter.count)
     {
-        b2Body_SetTransform(pr.bodyID,
-                            b2Vec2 {.x = -1.f * gRandom.getRandom(),
-                                    .y = (gHeight / 3.f)},
-                            b2MakeRot(0.f));
-        b2Body_Disable(pr.bodyID);
+        if (emitter.life[i] > 0.f && emitter.posY[i] < boundry.y + boundry.height &&
+            emitter.posX[i] > boundry.x && emitter.posX[i] < boundry.x + boundry.width)
+        {
+            ++i;
+            continue;
+        }
+        u32 const last  = --emitter.count;
+        emitter.posX[i] = emitter.posX[last];
+        emitter.posY[i]  = emitter.posY[last];
+        emitter.prevX[i] = emitter.prevX[last];
+        emitter.prevY[i] = emitter.prevY[last];
+        emitter.velX[i]  = emitter.velX[last];
+        emitter.velY[i] = emitter.velY[last];
+        emitter.life[i] = emitter.life[last];
+        emitter.size[i] = emitter.size[last];
     }
 }
+
+[[maybe_unused]]
+auto updateParticles(Emitter &         emitter,
+                     f32 const         dt,
+                     Vector2 const     gravity,
+                     f32 const         drag,
+                     Rectangle const & boundry) noexcept -> void
+{
+    PROFILE();
+    integrateParticles(emitter, dt, gravity, drag);
+    killParticles(emitter, boundry);
+}
+
+/*
+ *@Goal: copy what the render need (positions and sizes) of alive particles
+ *@Warning: to should have the same capacity as from (made by makeEmitter)
+ */
 [[maybe_unused]]
-auto resetParticle(Particle const & pr) noexcept -> void
+auto copyRenderState(Emitter const & from, Emitter & to) noexcept -> void
 {
-    b2Body_SetTransform(pr.bodyID,
-                        b2Vec2 {.x = -1.f * gRandom.getRandom(),
-                                .y = (gHeight / 3.f)},
-                        b2MakeRot(0.f));
-    b2Body_Disable(pr.bodyID);
+    auto const count = cast(std::ptrdiff_t, from.count);
+    std::copy_n(from.posX.begin(), count, to.posX.begin());
+    std::copy_n(from.posY.begin(), count, to.posY.begin());
+    std::copy_n(from.prevX.begin(), count, to.prevX.begin());
+    std::copy_n(from.prevY.begin(), count, to.prevY.begin());
+    std::copy_n(from.size.begin(), count, to.size.begin());
+    to.count = from.count;
+}
+
+/*
+ *@Goal: push the particles around the point away (e.g: keep the winning line clear)
+ *@Note: speed is added to the velocity at the point and fade to 0 at radius
+ *@Warning: grid should be built after the last update (indexes are emitter slots)
+ */
+[[maybe_unused]]
+auto repelParticles(Emitter &                    emitter,
+                    RA_Util::SpatialGrid const & grid,
+                    Vector2 const                point,
+                    f32 const                    radius,
+                    f32 const                    speed) noexcept -> void
+{
+    grid.queryRadius(point,
+                     radius,
+                     [&](u32 const i)
+                     {
+                         f32 const dx     = emitter.posX[i] - point.x;
+                         f32 const dy     = emitter.posY[i] - point.y;
+                         f32 const length = std::sqrt((dx * dx) + (dy * dy));
+                         if (length <= 0.f)
+                             return;
+                         f32 const scale = speed * (1.f - (length / radius)) / length;
+                         emitter.velX[i] += dx * scale;
+                         emitter.velY[i] += dy * scale;
+                     });
 }
+
+/*
+ *@Goal: draw alive particles with the pre rendered particle texture
+ *@Note: uv is the sprite in the texture (0 to 1, e.g. an atlas region)
+ *@Note: alpha (0 to 1) is where the render is between previous and current tick
+ *@Note: culling is per cell of the grid (built from the current positions):
+ * cells out of the view are skipped, cells inside are drawn without test
+ *@Note: padding is the biggest particle size + biggest move in one tick
+ *@Note: the batch is drawn with one call (per maxBatchQuads particles)
+ */
 [[maybe_unused]]
-auto drawParticles(std::span<Particle> const & particles,
-                   Texture2D const &           texture,
-                   Color                       color) noexcept -> void
-{
-    Rectangle const boundRect {.x      = -300.f,
-                               .y      = 0,
-                               .width  = cast(f32, gWidth),
-                               .height = gHeight + 50.f};
-
-    for (auto const pr : particles)
-    {
-        if (RA_Util::
-                isClippingForRender(Vector2 {.x = (b2Body_GetPosition(pr.bodyID).x * -1),
-                                             .y = (b2Body_GetPosition(pr.bodyID).y *
-                                                   -1)},
-                                    boundRect))
+auto drawEmitter(RA_Render::QuadBatch &       batch,
+                 Emitter const &              emitter,
+                 RA_Util::SpatialGrid const & grid,
+                 Texture2D const &            texture,
+                 Rectangle const &            uv,
+                 Color const                  color,
+                 Rectangle const &            view,
+                 f32 const                    padding,
+                 f32 const                    alpha) noexcept -> void
+{
+    PROFILE();
+    Shader const    shader = RA_Render::defaultShader();
+    f32 const       right  = view.x + view.width;
+    f32 const       bottom = view.y + view.height;
+    Rectangle const cullRect {.x      = view.x - padding,
+                              .y      = view.y - padding,
+                              .width  = view.width + (padding * 2.f),
+                              .height = view.height + (padding * 2.f)};
+    grid.forEachCell(
+        cullRect,
+        [&](std::span<u32 const> const items, std::span<Vector2 const>, bool const isInside)
+        {
+            for (u32 const i : items)
+            {
+                // between previous and current tick
+                f32 const x = emitter.prevX[i] + ((emitter.posX[i] - emitter.prevX[i]) * alpha);
+                f32 const y = emitter.prevY[i] + ((emitter.posY[i] - emitter.prevY[i]) * alpha);
+                f32 const size = emitter.size[i];
+                if (!isInside &&
+                    ((x + size) < view.x || x > right || (y + size) < view.y || y > bottom))
+                    continue;
+                Rectangle const dest {x, y, size, size};
+                if (!RA_Render::pushQuad(batch, dest, uv, color))
+                {
+                    RA_Render::flushQuadBatch(batch, shader, texture.id);
+                    (void)RA_Render::pushQuad(batch, dest, uv, color);
+                }
+            }
+        });
+    RA_Render::flushQuadBatch(batch, shader, texture.id);
+}
+}  // namespace RA_Particle
+
+namespace RA_Sim
+{
+
+/*
+ *@Goal: what the game want from the simulation (newest one wins)
+ *@Note: spawn/clear are counters so a request is not lost if the simulation
+ * skip some inputs
+ */
+struct SimInput
+{
+    u32                       spawnSerial {0};  // +1 => throw a wave of bodies
+    u32                       clearSerial {0};  // +1 => remove bodies and confetti
+    bool                      hasConfetti {false};
+    bool                      hasRepel {false};  // keep the winning line clear
+    std::array<Vector2, goal> repelPoints {};
+};
+
+/*
+ *@Goal: render state of one tick (read only for the render thread)
+ *@Note: confetti only has the positions and sizes (no velocity/life)
+ */
+struct SimSnapshot
+{
+    std::vector<Particle>                 bodies;  // active + resting bodies
+    RA_Particle::Emitter                  confetti;
+    RA_Util::SpatialGrid                  confettiGrid;
+    u64                                   tick {0};
+    std::chrono::steady_clock::time_point time {};  // when it is published
+};
+
+struct SimConfig
+{
+    f32                   tickRate {120.f};
+    u32                   maxSteps {8};
+    i32                   subStepCount {4};
+    u32                   workerCount {1};
+    u32                   bodyActiveCap {100};
+    u32                   bodyBatchSize {25};
+    u32                   bodyMaxCount {200};
+    Rectangle             bodyBoundry {};
+    u32                   confettiCount {0};
+    Vector2               confettiGravity {};
+    f32                   confettiDrag {0.f};
+    Rectangle             confettiBoundry {};
+    RA_Particle::EmitInfo confettiInfo {};
+    f32                   gridCellSize {128.f};
+    f32                   repelRadius {150.f};
+    f32                   repelAcceleration {3000.f};
+    u32                   lockStepTicks {0};  // != 0 => no thread (see step)
+};
+
+/*
+ *@Goal: simulation thread that own the box2d world, bodies and confetti
+ *@Note: game send SimInput and render read the newest SimSnapshot, both
+ * through triple buffers => no one wait for the other
+ *@Note: frame time is max(sim, render) instead of sim + render
+ *@Note: lockStepTicks != 0 => no thread, the loop call step() each iteration
+ * (record/replay => same ticks and random numbers on every run)
+ */
+class Simulation
+{
+public:
+
+    Simulation() = delete;
+    explicit Simulation(SimConfig const & config) :
+    m_config {config},
+    m_jobs {config.workerCount},
+    m_tasks {.jobs = &m_jobs},
+    m_worldID {RA_Particle::initWorldOfBox2d(m_tasks)},
+    m_bodyPool {RA_Particle::makeBodyPool(m_worldID,
+                                          config.bodyActiveCap,
+                                          config.bodyBatchSize,
+                                          config.bodyMaxCount)},
+    m_confetti {RA_Particle::makeEmitter(config.confettiCount)},
+    m_clock {config.tickRate, config.maxSteps},
+    m_inputs {SimInput {}},
+    m_snapshots {SimSnapshot {.bodies       = {},
+                              .confetti     = RA_Particle::makeEmitter(config.confettiCount),
+                              .confettiGrid = RA_Util::SpatialGrid(config.confettiBoundry,
+                                                                   config.gridCellSize)}},
+    m_thread {config.lockStepTicks == 0 ? std::thread {[this]() { run(); }} : std::thread {}}
+    {
+    }
+
+    ~Simulation()
+    {
+        m_isRunning.store(false, std::memory_order_release);
+        if (m_thread.joinable())
+            m_thread.join();
+        b2DestroyWorld(m_worldID);
+    }
+
+    // Deleted members
+    Simulation(Simulation const &)             = delete;
+    Simulation & operator=(Simulation const &) = delete;
+    Simulation(Simulation &&)                  = delete;
+    Simulation & operator=(Simulation &&)      = delete;
+
+    /*
+     *@Goal: send the game state to the simulation (game thread)
+     */
+    [[maybe_unused]]
+    auto pushInput(SimInput const & input) noexcept -> void
+    {
+        m_inputs.writeBuffer() = input;
+        m_inputs.publish();
+    }
+
+    /*
+     *@Goal: lock-step => lockStepTicks ticks of the last pushInput on the
+     * caller thread (fixed dt, not the wall clock)
+     *@Note: does nothing if the simulation has its own thread
+     */
+    [[maybe_unused]]
+    auto step() -> void
+    {
+        if (m_config.lockStepTicks == 0)
+            return;
+        (void)m_inputs.acquire();
+        SimInput const & input = m_inputs.readBuffer();
+        applyRequests(input);
+        for (u32 i = 0; i < m_config.lockStepTicks; ++i)
+            tick(input);
+        m_clock.advanceTicks(m_config.lockStepTicks);
+        publishSnapshot(input, m_config.lockStepTicks);
+    }
+
+    /*
+     *@Goal: simulated ticks so far (lock-step), 0 if it has its own thread
+     */
+    [[nodiscard]] [[maybe_unused]]
+    auto lockStepTick() const noexcept -> u64
+    {
+        return m_config.lockStepTicks == 0 ? 0 : m_clock.tickCount();
+    }
+
+    /*
+     *@Goal: newest snapshot (render thread)
+     *@Note: it stays valid till the next call
+     */
+    [[nodiscard]] [[maybe_unused]]
+    auto latest() noexcept -> SimSnapshot const &
+    {
+        (void)m_snapshots.acquire();
+        return m_snapshots.readBuffer();
+    }
+
+    /*
+     *@Goal: where the render is between previous and current tick of snapshot
+     */
+    [[nodiscard]] [[maybe_unused]]
+    auto alpha(SimSnapshot const & snapshot) const noexcept -> f32
+    {
+        // lock-step => snapshot is this iteration (same frames on replay)
+        if (m_config.lockStepTicks != 0)
+            return 1.f;
+        std::chrono::duration<f32> const elapsed = std::chrono::steady_clock::now() -
+                                                   snapshot.time;
+        return std::clamp(elapsed.count() / m_clock.tickSeconds(), 0.f, 1.f);
+    }
+
+private:
+
+    auto run() -> void
+    {
+        auto lastTime = std::chrono::steady_clock::now();
+        while (m_isRunning.load(std::memory_order_acquire))
         {
-            // b2Body_Disable(pr.bodyID);
-            resetParticle(pr);
-            impulseParticle(pr);
+            auto const                       now = std::chrono::steady_clock::now();
+            std::chrono::duration<f32> const frameTime = now - lastTime;
+            lastTime                                   = now;
+
+            (void)m_inputs.acquire();
+            SimInput const & input = m_inputs.readBuffer();
+            applyRequests(input);
+
+            u32 const steps = m_clock.advance(frameTime.count());
+            for (u32 step = 0; step < steps; ++step)
+                tick(input);
+            if (steps != 0)
+                publishSnapshot(input, steps);
+
+            // sleep till the next tick
+            std::this_thread::sleep_for(std::chrono::duration<f32>(
+                m_clock.tickSeconds() * (1.f - m_clock.alpha())));
         }
-        else
+    }
+
+    auto applyRequests(SimInput const & input) -> void
+    {
+        if (input.clearSerial != m_clearSerial)
+        {
+            m_clearSerial = input.clearSerial;
+            RA_Particle::clearBodies(m_bodyPool);
+            RA_Particle::clearParticles(m_confetti);
+        }
+        if (input.spawnSerial != m_spawnSerial)
         {
-            b2Vec2 const boxPos {b2Body_GetPosition(pr.bodyID)};
-            DrawTextureEx(texture,
-                          Vector2 {-boxPos.x, -boxPos.y},
-                          0.f,
-                          1.f * pr.rect.width / 10.f,
-                          color);
+            m_spawnSerial = input.spawnSerial;
+            RA_Particle::spawnBodies(m_bodyPool, m_bodyPool.activeCap);
+        }
+    }
+
+    auto tick(SimInput const & input) -> void
+    {
+        PROFILE();
+        f32 const dt = m_clock.tickSeconds();
+        // nothing to simulate when all the bodies are retired
+        if (m_bodyPool.activeCount != 0)
+        {
+            RA_Particle::stepWorld(m_worldID, dt, m_config.subStepCount, m_tasks);
+            RA_Particle::wakeRestingBodies(m_bodyPool);
+            RA_Particle::syncParticles(RA_Particle::activeBodies(m_bodyPool));
+            RA_Particle::retireBodies(m_bodyPool, m_config.bodyBoundry);
+        }
+        // particles just live on win/tie screen
+        if (input.hasConfetti)
+        {
+            // confetti update (refill)
+            RA_Particle::updateParticles(m_confetti,
+                                         dt,
+                                         m_config.confettiGravity,
+                                         m_config.confettiDrag,
+                                         m_config.confettiBoundry);
+            RA_Particle::emitParticles(m_confetti,
+                                       m_confetti.capacity - m_confetti.count,
+                                       m_config.confettiInfo);
         }
     }
-}
-}  // namespace RA_Particle
+
+    auto publishSnapshot(SimInput const & input, u32 const steps) -> void
+    {
+        PROFILE();
+        SimSnapshot & snapshot = m_snapshots.writeBuffer();
+        auto const    bodies   = RA_Particle::drawnBodies(m_bodyPool);
+        snapshot.bodies.assign(bodies.begin(), bodies.end());
+        RA_Particle::copyRenderState(m_confetti, snapshot.confetti);
+        // confetti by grid cell for culling and queries (same slots as m_confetti)
+        snapshot.confettiGrid.build(snapshot.confetti.count,
+                                    [&](u32 const i)
+                                    {
+                                        return Vector2 {snapshot.confetti.posX[i],
+                                                        snapshot.confetti.posY[i]};
+                                    });
+        if (input.hasConfetti && input.hasRepel)
+        {
+            f32 const push = m_config.repelAcceleration * m_clock.tickSeconds() *
+                             cast(f32, steps);
+            for (auto const & point : input.repelPoints)
+            {
+                RA_Particle::repelParticles(m_confetti,
+                                            snapshot.confettiGrid,
+                                            point,
+                                            m_config.repelRadius,
+                                            push);
+            }
+        }
+        snapshot.tick = m_clock.tickCount();
+        snapshot.time = std::chrono::steady_clock::now();
+        m_snapshots.publish();
+    }
+
+    SimConfig const                    m_config;
+    RA_Util::JobSystem                 m_jobs;
+    RA_Particle::Box2dTasks            m_tasks;
+    b2WorldId const                    m_worldID;
+    RA_Particle::BodyPool              m_bodyPool;
+    RA_Particle::Emitter               m_confetti;
+    RA_Util::FixedClock                m_clock;
+    RA_Util::TripleBuffer<SimInput>    m_inputs;
+    RA_Util::TripleBuffer<SimSnapshot> m_snapshots;
+    u32                                m_spawnSerial {0};
+    u32                                m_clearSerial {0};
+    std::atomic<bool>                  m_isRunning {true};
+    std::thread                        m_thread;  // last => starts after the rest
+};
+}  // namespace RA_Sim
 
 }  // namespace
 
 
 auto main([[maybe_unused]] int argc, [[maybe_unused]] char** argv) -> int
 {
+    auto const options = RA_Global::parseLaunchOptions(
+        std::span<char*> {argv, cast(std::size_t, argc)});
+    if (!options.has_value())
+    {
+        RA_Global::printUsage();
+        return 1;
+    }
+    // before anything use GRandom (record/replay reseed it)
+    RA_Util::InputSource inputSource {};
+    if (!options->recordPath.empty())
+        inputSource.startRecord(options->recordPath);
+    else if (!options->replayPath.empty() && !inputSource.startReplay(options->replayPath))
+    {
+        std::cerr << "Error: can not replay " << options->replayPath << '\n';
+        return 1;
+    }
 
-    // init window properties
-    SetConfigFlags(FLAG_MSAA_4X_HINT | FLAG_BORDERLESS_WINDOWED_MODE);
-    InitWindow(0, 0, "XOXO");
-
-    // find out the screen resulation
-    gHeight = GetMonitorHeight(GetCurrentMonitor());
-    gWidth  = GetMonitorWidth(GetCurrentMonitor());
-    // this is not standard or 0 bc above function not worked properly
-    if (gWidth < 1920 || gHeight < 1080)
-    {  // using diffrent aproche
-        gHeight = GetScreenHeight();
-        gWidth  = GetScreenWidth();
+    if (options->isHeadless)
+    {
+        // fixed internal resolution, nothing is shown (no monitor needed)
+        SetConfigFlags(FLAG_MSAA_4X_HINT | FLAG_WINDOW_HIDDEN);
+        InitWindow(cast(i32, options->width), cast(i32, options->height), "XOXO");
+        gWidth  = cast(i32, options->width);
+        gHeight = cast(i32, options->height);
+    }
+    else
+    {
+        // init window properties
+        SetConfigFlags(FLAG_MSAA_4X_HINT | FLAG_BORDERLESS_WINDOWED_MODE);
+        InitWindow(0, 0, "XOXO");
+
+        // find out the screen resulation
+        gHeight = GetMonitorHeight(GetCurrentMonitor());
+        gWidth  = GetMonitorWidth(GetCurrentMonitor());
+        // this is not standard or 0 bc above function not worked properly
+        if (gWidth < 1920 || gHeight < 1080)
+        {  // using diffrent aproche
+            gHeight = GetScreenHeight();
+            gWidth  = GetScreenWidth();
+        }
+        SetWindowSize(gWidth, gHeight);
     }
-    SetWindowSize(gWidth, gHeight);
 
     auto const fps = GetMonitorRefreshRate(0);
+    // record/replay: simulation is stepped by the loop (fixed ticks per
+    // iteration) => the loop target is the simulation rate / ticks
+    constexpr f32 const simTickRate {120.f};
+    constexpr u32 const lockStepTicks {2};
+    bool const          isLockStep = inputSource.mode() != RA_Util::InputMode::Live;
+    // raylib does not wait, the frame scheduler pace the loop (F: next mode)
+    // headless measure the draw path => never wait
     SetTargetFPS(0);
-    // toggle Full screen after the above setup
-    // bc if user has 2 monitor we want to run on focused screen
-    ToggleFullscreen();
-    // init Audio
-    InitAudioDevice();
+    RA_Util::FrameScheduler frameScheduler {options->isHeadless ? RA_Util::FrameMode::Uncapped
+                                                                : RA_Util::FrameMode::Target,
+                                            isLockStep
+                                                ? cast(f64, simTickRate / cast(f32, lockStepTicks))
+                                                : cast(f64, std::max(fps, 30)),
+                                            15.0};
+    if (!options->isHeadless)
+    {
+        // toggle Full screen after the above setup
+        // bc if user has 2 monitor we want to run on focused screen
+        ToggleFullscreen();
+        // init Audio (headless: no device => music calls do nothing)
+        InitAudioDevice();
+    }
     // load music
     Music music = LoadMusicStream(
         RA_Global::pathToFile("mini1111.xm"sv, RA_Global::EFileType::Audio).c_str());
@@ -1678,24 +5237,59 @@ auto main([[maybe_unused]] int argc, [[maybe_unused]] char** argv) -> int
     auto const defaultFontID=        RA_UI::getFontID(font);
     // clang-format on
 
-    // box2d init of the world of the game (box2d-related)
-    // Simulating setting (box2d-related)
-    b2WorldId const worldID = RA_Particle::initWorldOfBox2d();
-    // init memory for particles
-    constexpr u16 const                 particleCount {1000};
-    std::array<Particle, particleCount> particles {};
-    // create dynamic bodies
-    for (u16 i {}; i < particleCount; ++i)
-    {
-        Particle  pr {};
-        f32 const size = littleRandom.getRandom();
-        pr.rect.x      = gRandom.getRandom();
-        pr.rect.y      = (gHeight / -3.f);
-        pr.rect.height = size;
-        pr.rect.width  = size;
-        pr.bodyID      = RA_Particle::creatDynamicBody(pr, worldID);
-        particles[i]   = pr;
-    }
+    // box2d world, bodies and confetti live on the simulation thread
+    // cosmetic confetti (no collision => no box2d)
+    constexpr u32 const confettiCount {20'000};
+    f32 const           confettiMaxSize {24.f};
+    // physics clock: 120 ticks per second, at most 8 ticks per loop
+    // bodies are spawned above the screen (y = -gHeight / 3)
+    // project wide jobs (box2d solver, ...) => simulation thread is worker 0
+    // (record/replay: no simulation thread, the loop step it => loop thread)
+    RA_Sim::Simulation simulation(RA_Sim::SimConfig {
+        .tickRate        = simTickRate,
+        .maxSteps        = 8,
+        .subStepCount    = 4,
+        .workerCount     = std::clamp(std::thread::hardware_concurrency(), 1U, 8U),
+        .bodyActiveCap   = 100,
+        .bodyBatchSize   = 25,
+        .bodyMaxCount    = 200,
+        .bodyBoundry     = Rectangle {.x      = -300.f,
+                                      .y      = -cast(f32, gHeight),
+                                      .width  = gWidth + 300.f,
+                                      .height = (gHeight * 2.f) + 50.f},
+        .confettiCount   = confettiCount,
+        .confettiGravity = Vector2 {0.f, 400.f},
+        .confettiDrag    = 0.4f,
+        .confettiBoundry = Rectangle {.x      = -300.f,
+                                      .y      = -gHeight / 2.f,
+                                      .width  = gWidth + 600.f,
+                                      .height = (gHeight * 1.5f) + 50.f},
+        .confettiInfo =
+            RA_Particle::EmitInfo {.area        = Rectangle {.x      = -gWidth * .2f,
+                                                             .y      = -gHeight / 3.f,
+                                                             .width  = gWidth * 1.4f,
+                                                             .height = gHeight / 3.f},
+                                   .minVelocity = Vector2 {-150.f, -200.f},
+                                   .maxVelocity = Vector2 {150.f, 150.f},
+                                   .minLife     = 2.f,
+                                   .maxLife     = 5.f,
+                                   .minSize     = 8.f,
+                                   .maxSize     = confettiMaxSize},
+        // cells are bigger than the biggest confetti
+        .gridCellSize      = 128.f,
+        .repelRadius       = 150.f,
+        .repelAcceleration = 3000.f,
+        .lockStepTicks     = isLockStep ? lockStepTicks : 0});
+    // what the game want from the simulation (sent each frame)
+    RA_Sim::SimInput     simInput {};
+    RA_Render::QuadBatch confettiBatch = RA_Render::makeQuadBatch(confettiCount);
+    // sorted draw commands (cells, ...) and their batch
+    RA_Render::CommandQueue renderQueue {};
+    RA_Render::QuadBatch    commandBatch = RA_Render::makeQuadBatch(1024);
+    RA_Render::RenderStats  renderStats {};
+    // biggest confetti + biggest move in one tick
+    f32 const            confettiPadding {confettiMaxSize + 32.f};
+    Rectangle const      screenRect {0.f, 0.f, cast(f32, gWidth), cast(f32, gHeight)};
 
     auto const gridinfo = RA_Util::
         createGridInfo(RA_Util::placeRelativeCenter(Rectangle {0.f,
@@ -1707,12 +5301,11 @@ auto main([[maybe_unused]] int argc, [[maybe_unused]] char** argv) -> int
                        column,
                        row);
 
-    Texture2D const gridTexture {
-        RA_Util::genGridTexture(gridinfo, .1f, 5.0f, WHITE, Color {0, 0, 0, 0})};
-
-    // touched rects
-    std::vector<PlayerShapeInfo> rects;
-    rects.reserve(row * column);
+    // render data of touched cells (valid if the cell is occupied on the board)
+    std::array<PlayerShapeInfo, row * column> cellShapes {};
+    // grow animation of a new cell (Cell.fs) => not idle till it ends
+    constexpr f64 const cellGrowSeconds {0.25};
+    f64                 lastPlacedTime {-cellGrowSeconds};
     // indexes of rects that caus win
     std::array<u8, goal>      indexCausWin {};
     std::array<Vector2, goal> circles {};
@@ -1720,14 +5313,18 @@ auto main([[maybe_unused]] int argc, [[maybe_unused]] char** argv) -> int
                                       .target   = Vector2 {},
                                       .rotation = 0.f,
                                       .zoom     = 1.0f};
-    // player1
-    Player p1 {.moves = {}, .rectColor = {200, 0, 0, 255}, .name = "Red"s, .id = 0};
-    // player2
-    Player p2 {.moves = {}, .rectColor = {0, 0, 230, 255}, .name = "Blue"s, .id = 1};
+    // rules of the game (no raylib in there)
+    RA_Game::Variant const variant = RA_Game::makeVariant(column, row, goal);
+    RA_Game::Board         board {};
+
+    // player1 and player2 (index is RA_Game::Board::turn)
+    std::array<Player, RA_Game::playerCount> const players {
+        Player {.rectColor = {200, 0, 0, 255}, .name = "Red"s, .id = 0},
+        Player {.rectColor = {0, 0, 230, 255}, .name = "Blue"s, .id = 1}};
 
     // current player
-    Player* currentPlayer = &p1;
-    Player* wonPlayer {nullptr};
+    Player const* currentPlayer = &players[board.turn];
+    Player const* wonPlayer {nullptr};
 
     // UI elements init
     RA_UI::initUI();
@@ -1757,6 +5354,12 @@ auto main([[maybe_unused]] int argc, [[maybe_unused]] char** argv) -> int
                                            defaultFontID,
                                            25,
                                            Vector2 {50.f, 40.f});
+    // draw calls of the render queue (previous frame)
+    auto const renderStatsLblID = RA_UI::makeLable("draw calls: 0 state changes: 0",
+                                                   WHITE,
+                                                   defaultFontID,
+                                                   25,
+                                                   Vector2 {50.f, 70.f});
     // turn lable
     auto const turnLblID = RA_UI::makeLable("Turn",
                                             currentPlayer->rectColor,
@@ -1790,16 +5393,22 @@ auto main([[maybe_unused]] int argc, [[maybe_unused]] char** argv) -> int
                                     cast(u16, gHeight * .5f),
                                     1,
                                     PIXELFORMAT_UNCOMPRESSED_R8G8B8A8};
-    RenderTexture2D const
-        mainRenderTexture = LoadRenderTexture(cast(u16, gWidth * .5f),
-                                              cast(u16, gHeight * .5f));
+    // main target is laid out for half of the screen (mainLayoutScale) and the
+    // real scale follow the frame time (full resolution on fast machines)
+    constexpr f32 const          mainLayoutScale {.5f};
+    Rectangle const              mainLayoutRect {.x      = 0.f,
+                                                 .y      = 0.f,
+                                                 .width  = cast(f32, gWidth) * mainLayoutScale,
+                                                 .height = cast(f32, gHeight) * mainLayoutScale};
+    RA_Render::DynamicResolution mainResolution = RA_Render::
+        makeDynamicResolution(gWidth, gHeight, .25f, 1.f, 4, cast(f32, std::max(fps, 30)));
+
 
+    // linked programs are cached on disk => next launches skip the compile
+    RA_Shader::ShaderCache shaderCache = RA_Shader::makeShaderCache();
 
     // particle shader and render texture init
-    Shader const particleShader = LoadShader(nullptr,
-                                             RA_Global::pathToFile("particle.fs"sv,
-                                                                   RA_Global::EFileType::Shader)
-                                                 .c_str());
+    Shader const particleShader = RA_Shader::loadShader(shaderCache, ""sv, "particle.fs"sv);
     i32 const    resLocParticle = GetShaderLocation(particleShader, "iRes");
     SetShaderValue(particleShader, resLocParticle, iRes, SHADER_UNIFORM_VEC2);
 
@@ -1809,37 +5418,40 @@ auto main([[maybe_unused]] int argc, [[maybe_unused]] char** argv) -> int
                      cast(f32, currentPlayer->rectColor.g),
                      cast(f32, currentPlayer->rectColor.b)};
 
-    Shader const
-              backgroundShader  = LoadShader(nullptr,
-                                      RA_Global::pathToFile("background.fs"sv,
-                                                            RA_Global::EFileType::Shader)
-                                          .c_str());
-    i32 const resLocBackground  = GetShaderLocation(backgroundShader, "iRes");
-    i32 const timeLocBackground = GetShaderLocation(backgroundShader, "iTime");
-    i32 const colorLoc          = GetShaderLocation(backgroundShader, "iColor");
-    SetShaderValue(backgroundShader, resLocBackground, iRes, SHADER_UNIFORM_VEC2);
-    SetShaderValue(backgroundShader, timeLocBackground, &iTime, SHADER_UNIFORM_FLOAT);
-    SetShaderValue(backgroundShader, colorLoc, iColor, SHADER_UNIFORM_VEC3);
-
-    // Circular Cell Shader
-    Shader const circleShader = LoadShader(nullptr,
-                                           RA_Global::pathToFile("CircleCell.fs"sv,
-                                                                 RA_Global::EFileType::Shader)
-                                               .c_str());
-    i32 const    resLocCell   = GetShaderLocation(circleShader, "iRes");
-    i32 const    timeLocCell  = GetShaderLocation(circleShader, "iTime");
-    SetShaderValue(circleShader, resLocCell, iRes, SHADER_UNIFORM_VEC2);
-    SetShaderValue(circleShader, timeLocCell, &iTime, SHADER_UNIFORM_FLOAT);
-
-    // Cross Cell Shader
-    Shader const crossShader      = LoadShader(nullptr,
-                                          RA_Global::pathToFile("CrossCell.fs"sv,
-                                                                RA_Global::EFileType::Shader)
-                                              .c_str());
-    i32 const    resLocCrossCell  = GetShaderLocation(crossShader, "iRes");
-    i32 const    timeLocCrossCell = GetShaderLocation(crossShader, "iTime");
-    SetShaderValue(crossShader, resLocCrossCell, iRes, SHADER_UNIFORM_VEC2);
-    SetShaderValue(crossShader, timeLocCrossCell, &iTime, SHADER_UNIFORM_FLOAT);
+    Shader const backgroundShader = RA_Shader::loadShader(shaderCache,
+                                                          ""sv,
+                                                          "background.fs"sv);
+    // background is cached: 30 renders per second at quarter of the screen
+    // (half of the main target) => iPixelScale keep the pattern the same
+    RA_Render::CachedLayer backgroundLayer = RA_Render::
+        makeCachedLayer(cast(i32, mainLayoutRect.width),
+                        cast(i32, mainLayoutRect.height),
+                        .5f,
+                        30.f,
+                        .01f);
+    f32 const iPixelScale {mainLayoutRect.width /
+                           cast(f32, backgroundLayer.target.texture.width)};
+    // uniforms are uploaded only if they are changed (before each render)
+    RA_Render::ShaderUniforms backgroundUniforms =
+        RA_Render::makeShaderUniforms(backgroundShader, "background"sv);
+    RA_Render::addUniform(backgroundUniforms, "iRes"sv, iRes);
+    RA_Render::addUniform(backgroundUniforms, "iTime"sv, std::span {&iTime, 1});
+    RA_Render::addUniform(backgroundUniforms, "iColor"sv, iColor);
+    RA_Render::addUniform(backgroundUniforms, "iPixelScale"sv, std::span {&iPixelScale, 1});
+
+    // Cell Shader (circle and cross in one shader => all cells in one draw)
+    Shader const cellShader = RA_Shader::loadShader(shaderCache, "Cell.vs"sv, "Cell.fs"sv);
+    // grid lines (sdf shader, texture is made only if the shader is not there)
+    RA_Render::GridRenderer gridRenderer = RA_Render::makeGridRenderer(shaderCache, gridinfo);
+    // win circles, win line and button borders (sdf shapes => one draw call)
+    RA_Render::ShapeRenderer shapeRenderer = RA_Render::makeShapeRenderer(shaderCache,
+                                                                          commandBatch);
+    PROFILE_COUNTER("shader cache hits", shaderCache.hitCount);
+    PROFILE_COUNTER("shader cache misses", shaderCache.missCount);
+    RA_Render::ShaderUniforms cellUniforms =
+        RA_Render::makeShaderUniforms(cellShader, "cell"sv);
+    RA_Render::addUniform(cellUniforms, "iRes"sv, iRes);
+    RA_Render::addUniform(cellUniforms, "iTime"sv, std::span {&iTime, 1});
 
     // pre render particle shader on a small texture for using in particle drawing
     BeginTextureMode(particleRenderTexture);
@@ -1855,21 +5467,81 @@ auto main([[maybe_unused]] int argc, [[maybe_unused]] char** argv) -> int
     }
     EndTextureMode();
     UnloadTexture(particleTexture);
+    // sprites share atlas pages (one texture for particles, confetti, ...)
+    RA_Render::TextureAtlas spriteAtlas = RA_Render::makeTextureAtlas(512, 2);
+    auto const particleSprite = RA_Render::insertTexture(spriteAtlas,
+                                                         particleRenderTexture.texture);
+    RA_Util::checkAtRuntime(!particleSprite.has_value(),
+                            "particle sprite does not fit in the atlas"sv);
+    UnloadRenderTexture(particleRenderTexture);
+    Texture2D const spriteTexture = RA_Render::atlasTexture(spriteAtlas, *particleSprite);
     UnloadShader(particleShader);
 
 
+    // back to the first move (reset button and back key)
+    auto const resetGame = [&]() -> void
+    {
+        RA_Game::reset(board);
+        currentState = GameState::none;
+        indexCausWin.fill(0);
+        ++simInput.clearSerial;
+        currentPlayer       = &players[board.turn];
+        wonPlayer           = nullptr;
+        canReset            = false;
+        winUIFramCounter    = 0;
+        winFrameLimit       = 10;
+        winAnimState        = 1;
+        uIPointAnimationWin = {};
+        winAnimResetFrame   = 40;
+        RA_UI::updateLable(gameStateLblID, "", WHITE, 100, true, Vector2 {});
+        iColor[0] = currentPlayer->rectColor.r;
+        iColor[1] = currentPlayer->rectColor.g;
+        iColor[2] = currentPlayer->rectColor.b;
+    };
+
+    // headless run: frame times and the auto player
+    std::vector<f32> headlessFrameTimes {};
+    headlessFrameTimes.reserve(options->isHeadless ? options->frameCount : 0);
+    RA_Game::PolicyFn const autoPolicy = RA_Game::findPolicy("random"sv);
+    RA_Game::FastRandom     autoRandom {7};  // same moves on every run
+    u32                     autoPlayFrames {0};
+
     // game loop
+    frameScheduler.restart();
     while (currentState != GameState::end)
     {
+        // input of this tick (device, device + recording or a replay)
+        RA_Util::TickInput const input = inputSource.poll(simulation.lockStepTick());
+        // click of this frame (hit test of the grid just happen on click)
+        std::optional<Vector2> clickPos {};
         // input
         {
+            if (options->isHeadless && inputSource.mode() != RA_Util::InputMode::Replay)
+            {
+                // auto play: a move every few frames and reset after the
+                // win/tie animations => the whole draw path is measured
+                ++autoPlayFrames;
+                if (currentState == GameState::none && autoPlayFrames >= 8)
+                {
+                    Rectangle const rect = RA_Util::
+                        cell2RectOnGrid(autoPolicy(board, variant, autoRandom), gridinfo);
+                    clickPos       = Vector2 {rect.x + (rect.width / 2.f),
+                                        rect.y + (rect.height / 2.f)};
+                    autoPlayFrames = 0;
+                }
+                else if (currentState != GameState::none && autoPlayFrames >= 120)
+                {
+                    canReset       = true;
+                    autoPlayFrames = 0;
+                }
+            }
             // make input less responsive bc dont need every fram input
-            if (IsMouseButtonPressed(MOUSE_LEFT_BUTTON))
+            else if (input.click.has_value())
             {
-                mousePos = GetTouchPosition(0);
+                clickPos = input.click;
                 // ui hit detection
                 // reset state is true
-                if (CheckCollisionPointRec(mousePos, RA_UI::getBtnRect(resetBtnID)))
+                if (CheckCollisionPointRec(*clickPos, RA_UI::getBtnRect(resetBtnID)))
                 {
                     canReset = true;
 #if defined(PLATFORM_ANDROID)
@@ -1877,29 +5549,14 @@ auto main([[maybe_unused]] int argc, [[maybe_unused]] char** argv) -> int
 #endif
                 }
             }
-            else if (IsKeyPressed(KEY_ESCAPE))
+            else if (input.isQuit)
                 currentState = GameState::end;
-            else if (IsKeyPressed(KEY_BACK))
+            else if (input.isNextFrameMode)
+                frameScheduler.nextMode();
+            else if (input.isBack)
             {
                 // TODO: reset game state then leave the game
-                currentState = GameState::none;
-                p1.moves.reset();
-                p2.moves.reset();
-                rects.clear();
-                indexCausWin.fill(0);
-                RA_Particle::resetParticles(particles);
-                currentPlayer       = &p1;
-                wonPlayer           = nullptr;
-                canReset            = false;
-                winUIFramCounter    = 0;
-                winFrameLimit       = 10;
-                winAnimState        = 1;
-                uIPointAnimationWin = {};
-                winAnimResetFrame   = 40;
-                RA_UI::updateLable(gameStateLblID, "", WHITE, 100, true, Vector2 {});
-                iColor[0] = currentPlayer->rectColor.r;
-                iColor[1] = currentPlayer->rectColor.g;
-                iColor[2] = currentPlayer->rectColor.b;
+                resetGame();
                 RA_UI::cleanUI();
                 break;
             }
@@ -1911,96 +5568,75 @@ auto main([[maybe_unused]] int argc, [[maybe_unused]] char** argv) -> int
 
             // update shader loc address
             iTime = RA_Util::correctTime(20.f);
-            // setting time for shaders
-            SetShaderValue(backgroundShader,
-                           timeLocBackground,
-                           &iTime,
-                           SHADER_UNIFORM_FLOAT);
-            SetShaderValue(circleShader, timeLocCell, &iTime, SHADER_UNIFORM_FLOAT);
-            SetShaderValue(crossShader, timeLocCrossCell, &iTime, SHADER_UNIFORM_FLOAT);
-
-            // setting current player color to background shader effect
-            SetShaderValue(backgroundShader, colorLoc, iColor, SHADER_UNIFORM_VEC3);
-
-            // physiques update
-            {
-                // box2d Update world state (box2d-related)
-                f32 const           fps = GetFPS();
-                constexpr i32 const subStepCount {3};
-                f32 const           timeStep = 1.f /
-                                     ((fps > 120) ? (fps / subStepCount) : (fps));
-                b2World_Step(worldID, timeStep, subStepCount);
-            }
+            // setting time for shaders (background is set when it is rendered)
+            RA_Render::setUniform(cellUniforms, "iTime"sv, iTime);
+
             // update game state
             if (currentState == GameState::none)
             {
                 // update game based on input
-                // what is the sub-rectangle on the grid + index of that rectangle in optional type
-                auto const selectedRect {
-                    RA_Util::point2RectOnGrid(mousePos, gridinfo)};
+                // which cell of the grid is clicked (cell id is the board cell)
+                auto const selectedCell {
+                    clickPos.has_value()
+                        ? RA_Util::point2CellOnGrid(*clickPos, gridinfo)
+                        : std::nullopt};
                 // if player touch inside grid
-                if (selectedRect.has_value())
+                if (selectedCell.has_value())
                 {
-                    auto const indexRect = RA_Util::point2IndexOnGrid(mousePos,
-                                                                      gridinfo);
-                    // create new rect inside the rect that touched with player color
-                    // new rect should adjust size and coordinate inside the
-                    // parent (touched rect) adjust color based on current player
-                    PlayerShapeInfo const
-                        newRect(RA_Util::placeRelativeCenter(selectedRect.value(), 55, 55),
-                                currentPlayer->rectColor,
-                                currentPlayer->id);
-
-                    // if this new rect does not exist in buffer add it to buffer
-                    if (std::ranges::find(std::cbegin(rects),
-                                          std::cend(rects),
-                                          newRect) == std::cend(rects))
+                    auto const cell = cast(u8, *selectedCell);
+                    // rules engine reject occupied cells (one bit test) and
+                    // moves after the end
+                    if (RA_Game::applyMove(board, variant, cell))
                     {
-                        rects.emplace_back(newRect);
-                        // each rect index is 1 or 0 based on
-                        // previouse touched on it bitset start
-                        // from zero but rect index start from 1
-                        // => so we should do: indexRect -1
-                        currentPlayer->moves.set((indexRect)-1, true);
-                        // check for win condition on LookUpTable bitsets => bit by bit
-                        for (auto const n : winTable)
+                        // create new rect inside the rect that touched with player color
+                        // new rect should adjust size and coordinate inside the
+                        // parent (touched rect) adjust color based on current player
+                        cellShapes[cell] = PlayerShapeInfo(
+                            RA_Util::placeRelativeCenter(RA_Util::cell2RectOnGrid(cell,
+                                                                                  gridinfo),
+                                                         55,
+                                                         55),
+                            currentPlayer->rectColor,
+                            currentPlayer->id,
+                            GetTime());
+                        lastPlacedTime = cellShapes[cell].placedTime;
+                        switch (RA_Game::status(board))
                         {
-                            u8 counter {};
-                            for (u32 i = 0; i < currentPlayer->moves.size(); ++i)
+                            case RA_Game::EOutcome::firstWon:
+                                [[fallthrough]];
+                            case RA_Game::EOutcome::secondWon:
                             {
-                                // if both bit are 1
-                                if (currentPlayer->moves[i] && n[i])
+                                currentState = GameState::win;
+                                // grid indexes of the line for win animation and
+                                // drawing stuff (ascending like the old bit order)
+                                u64 line = RA_Game::winningLine(board, variant);
+                                for (u8 & index : indexCausWin)
                                 {
-                                    // add this index it to index
-                                    // buffer for win animation and drawing stuff
-                                    indexCausWin[counter] = cast(u8, i + 1);
-                                    counter++;
+                                    auto const highest = cast(
+                                        u8,
+                                        63 - std::countl_zero(line));
+                                    index = cast(u8, (row * column) - highest);
+                                    line &= ~(u64 {1} << highest);
                                 }
-                            }
-                            // if 3 bits is set it means you match one
-                            // of the winTable numbers
-                            // ToDo : this 3 should change based on row* col size
-                            if (counter == goal)
-                            {
-                                currentState = GameState::win;
                                 break;
                             }
-                        }
-                        // change current player to next player if the game is going on
-                        if (currentState == GameState::none)
-                        {
-                            if (currentPlayer->id == p1.id)
+                            case RA_Game::EOutcome::tie:
                             {
-                                currentPlayer = &p2;
+                                currentState = GameState::tie;
+                                break;
                             }
-                            else
+                            case RA_Game::EOutcome::none:
+                                [[fallthrough]];
+                            default:
                             {
-                                currentPlayer = &p1;
+                                // change current player to next player
+                                currentPlayer = &players[board.turn];
+                                // update player color for background shader
+                                iColor[0] = currentPlayer->rectColor.r;
+                                iColor[1] = currentPlayer->rectColor.g;
+                                iColor[2] = currentPlayer->rectColor.b;
+                                break;
                             }
-                            // update player color for background shader
-                            iColor[0] = currentPlayer->rectColor.r;
-                            iColor[1] = currentPlayer->rectColor.g;
-                            iColor[2] = currentPlayer->rectColor.b;
                         }
                     }
                 }
@@ -2013,7 +5649,7 @@ auto main([[maybe_unused]] int argc, [[maybe_unused]] char** argv) -> int
                                                                            gridinfo);
                     circles = RA_Anim::defineCircles(gridinfo, indexCausWin);
                     uIPointAnimationWin = circles[goal - 1];
-                    RA_Particle::impulseParticles(particles);
+                    ++simInput.spawnSerial;
                     RA_UI::updateLable(gameStateLblID,
                                        str {wonPlayer->name + " Won"s}.c_str(),
                                        wonPlayer->rectColor,
@@ -2031,16 +5667,14 @@ auto main([[maybe_unused]] int argc, [[maybe_unused]] char** argv) -> int
                                                 5.f});
                 }
                 // update tie state
-                // touched rect buffer is full but no one won the game
-                else if (rects.size() == (row * column) &&
-                         currentState == GameState::none)
+                // board is full but no one won the game
+                else if (currentState == GameState::tie)
                 {
-                    currentState = GameState::tie;
                     // White color
                     iColor[0] = 255;
                     iColor[1] = 255;
                     iColor[2] = 255;
-                    RA_Particle::impulseParticles(particles);
+                    ++simInput.spawnSerial;
                     RA_UI::updateLable(gameStateLblID,
                                        "Tie",
                                        WHITE,
@@ -2057,25 +5691,7 @@ auto main([[maybe_unused]] int argc, [[maybe_unused]] char** argv) -> int
             // reset button clicked
             if (canReset)
             {
-                currentState = GameState::none;
-                p1.moves.reset();
-                p2.moves.reset();
-                rects.clear();
-                indexCausWin.fill(0);
-                RA_Particle::resetParticles(particles);
-                currentPlayer       = &p1;
-                wonPlayer           = nullptr;
-                canReset            = false;
-                winUIFramCounter    = 0;
-                winFrameLimit       = 10;
-                winAnimState        = 1;
-                uIPointAnimationWin = {};
-                winAnimResetFrame   = 40;
-                RA_UI::updateLable(gameStateLblID, "", WHITE, 100, true, Vector2 {});
-                iColor[0] = currentPlayer->rectColor.r;
-                iColor[1] = currentPlayer->rectColor.g;
-                iColor[2] = currentPlayer->rectColor.b;
-                // RA_Game::resetGameState();
+                resetGame();
             }
             RA_UI::updateLable(fpsLblID,
                                TextFormat("FPS: %d", GetFPS()),
@@ -2084,6 +5700,20 @@ auto main([[maybe_unused]] int argc, [[maybe_unused]] char** argv) -> int
                                false,
                                Vector2 {50.f, 40.f});
 
+            RA_UI::updateLable(renderStatsLblID,
+                               TextFormat("draw calls: %u state changes: %u scale: %.2f "
+                                          "cpu: %.2f ms (%s)",
+                                          renderStats.drawCalls,
+                                          renderStats.shaderChanges +
+                                              renderStats.textureChanges,
+                                          cast(f64, RA_Render::renderScale(mainResolution)),
+                                          frameScheduler.cpuSeconds() * 1000.0,
+                                          frameScheduler.modeName()),
+                               WHITE,
+                               25,
+                               false,
+                               Vector2 {50.f, 70.f});
+
             RA_UI::updateLable(turnLblID,
                                "Turn",
                                currentPlayer->rectColor,
@@ -2091,92 +5721,139 @@ auto main([[maybe_unused]] int argc, [[maybe_unused]] char** argv) -> int
                                (currentState == GameState::win ||
                                 currentState == GameState::tie),
                                Vector2 {70.f, 350.f});
+
+            // send the game state to the simulation thread
+            simInput.hasConfetti = currentState == GameState::win ||
+                                   currentState == GameState::tie;
+            simInput.hasRepel    = currentState == GameState::win;
+            simInput.repelPoints = circles;
+            simulation.pushInput(simInput);
+            simulation.step();  // lock-step only
         }
         // draw game loop
         {
+            // newest tick of the simulation thread (no lock)
+            RA_Sim::SimSnapshot const & snapshot = simulation.latest();
+            f32 const                   simAlpha = simulation.alpha(snapshot);
+            // background cache (before the main texture mode, they can not nest)
+            // current player color is the background shader effect
+            if (RA_Render::shouldRenderLayer(backgroundLayer, GetTime(), iTime, iColor))
+            {
+                RA_Render::setUniform(backgroundUniforms, "iTime"sv, iTime);
+                RA_Render::setUniform(backgroundUniforms, "iColor"sv, iColor);
+                RA_Render::uploadUniforms(backgroundUniforms);
+                RA_Render::renderCachedLayer(backgroundLayer, backgroundShader);
+            }
+            // render scale of this frame (from the previous frame times)
+            // frame time without the scheduler wait (GetFrameTime has it)
+            // headless keep the full scale => runs are comparable
+            if (!options->isHeadless)
+                (void)RA_Render::updateDynamicResolution(mainResolution,
+                                                         frameScheduler.workSeconds());
+            RenderTexture2D const & mainRenderTexture = RA_Render::renderTarget(mainResolution);
             {
                 BeginTextureMode(mainRenderTexture);
+                // layout units => pixels of the current target
+                BeginMode2D(Camera2D {.offset   = Vector2 {},
+                                      .target   = Vector2 {},
+                                      .rotation = 0.f,
+                                      .zoom     = RA_Render::renderScale(mainResolution) /
+                                              mainLayoutScale});
                 {
                     ClearBackground(BLANK);
-                    {
-
-                        // writing background shader to render Target
-                        {
-                            BeginShaderMode(backgroundShader);
-                            DrawTexture(shapeTexture, 0, 0, WHITE);
-                            EndShaderMode();
-                        }
-                        // writing cell shader to same render target
-                        {
-                            for (auto const & rect : rects)
-                            {
-                                if (rect.id == p1.id)
-                                {
-                                    BeginShaderMode(circleShader);
-                                    // bottom-left is origin for glsl
-                                    DrawTexturePro(shapeTexture,
-                                                   {.x      = 0.f,
-                                                    .y      = 0.f,
-                                                    .width  = gWidth * .5f,
-                                                    .height = gHeight * .5f},
-                                                   {.x = (rect.rect.x * .5f) -
-                                                         (rect.rect.width * 0.25f),
-                                                    .y = (gHeight * .5f) -
-                                                         ((rect.rect.y * .5f) -
-                                                          (rect.rect.height * .25f)) -
-                                                         (rect.rect.height),
-                                                    .width  = rect.rect.width,
-                                                    .height = rect.rect.height},
-                                                   {},
-                                                   0.f,
-                                                   WHITE);
-                                    EndShaderMode();
-                                }
-                                else  // its p2
-                                {
-                                    BeginShaderMode(crossShader);
-                                    // bottom-left is origin for glsl
-                                    DrawTexturePro(shapeTexture,
-                                                   {.x      = 0.f,
-                                                    .y      = 0.f,
-                                                    .width  = gWidth * .5f,
-                                                    .height = gHeight * .5f},
-                                                   {.x = (rect.rect.x * .5f) -
-                                                         (rect.rect.width * 0.25f),
-                                                    .y = (gHeight * .5f) -
-                                                         ((rect.rect.y * .5f) -
-                                                          (rect.rect.height * .25f)) -
-                                                         (rect.rect.height),
-                                                    .width  = rect.rect.width,
-                                                    .height = rect.rect.height},
-                                                   {},
-                                                   0.f,
-                                                   WHITE);
-                                    EndShaderMode();
-                                }
-                            }
-                        }
+                    // cached background, cells and then grid (order is the layer)
+                    RA_Render::pushDraw(renderQueue,
+                                        RA_Render::RenderLayer::background,
+                                        0,
+                                        [&backgroundLayer, &mainLayoutRect]()
+                                        {
+                                            RA_Render::drawCachedLayer(backgroundLayer,
+                                                                       mainLayoutRect);
+                                        });
+                    // just the occupied cells, one run of the cell shader
+                    RA_Render::uploadUniforms(cellUniforms);
+                    RA_Render::pushCells(renderQueue,
+                                         RA_Game::occupied(board),
+                                         cellShapes,
+                                         cellShader,
+                                         shapeTexture.id,
+                                         GetTime());
+                    // draw grid (layout units, 10 pixel lines on screen)
+                    RA_Render::pushDraw(
+                        renderQueue,
+                        RA_Render::RenderLayer::grid,
+                        0,
+                        [&gridRenderer, &gridinfo, &mainResolution]()
                         {
-                            // draw grid
-                            DrawTextureEx(gridTexture,
-                                          {gridinfo.rect.x -
-                                               (gridinfo.rect.width * .25f),
-                                           gridinfo.rect.y -
-                                               (gridinfo.rect.height * 0.0625f)}, /* its (0.25f*0.25f)*/
-                                          0.f,
-                                          5.f, /*its aloso multiply by 2 when drawing on screen 5*2=10*/
-                                          WHITE);
-                        }
-                    }
+                            RA_Render::drawGridLines(
+                                gridRenderer,
+                                gridinfo,
+                                Rectangle {.x      = gridinfo.rect.x * mainLayoutScale,
+                                           .y      = gridinfo.rect.y * mainLayoutScale,
+                                           .width  = gridinfo.rect.width * mainLayoutScale,
+                                           .height = gridinfo.rect.height * mainLayoutScale},
+                                RA_Render::renderScale(mainResolution),
+                                10.f,
+                                WHITE);
+                        });
+                    renderStats = RA_Render::submitCommands(renderQueue, commandBatch);
                 }
+                EndMode2D();
                 EndTextureMode();
             }
 
             ClearBackground(BLANK);
             BeginDrawing();
             BeginMode2D(camera);
-            DrawTextureEx(mainRenderTexture.texture, {}, 0.f, 2.f, WHITE);
+            RA_Render::setShapePixelScale(shapeRenderer, camera.zoom);
+            // main target is the background of the screen pass
+            RA_Render::pushDraw(renderQueue,
+                                RA_Render::RenderLayer::background,
+                                0,
+                                [&mainRenderTexture, &screenRect]()
+                                {
+                                    Texture2D const & texture = mainRenderTexture.texture;
+                                    DrawTexturePro(texture,
+                                                   Rectangle {0.f,
+                                                              0.f,
+                                                              cast(f32, texture.width),
+                                                              cast(f32, texture.height)},
+                                                   screenRect,
+                                                   Vector2 {},
+                                                   0.f,
+                                                   WHITE);
+                                });
             // state specific drawing animation and etc ...
+            // effect depths: 0 circles | 1 line | 2 bodies | 3 confetti
+            auto const pushParticles = [&](Color const color)
+            {
+                RA_Render::pushDraw(renderQueue,
+                                    RA_Render::RenderLayer::effect,
+                                    2,
+                                    [&, color, simAlpha]()
+                                    {
+                                        RA_Particle::drawParticles(snapshot.bodies,
+                                                                   spriteTexture,
+                                                                   particleSprite->rect,
+                                                                   color,
+                                                                   simAlpha);
+                                    });
+                RA_Render::pushDraw(renderQueue,
+                                    RA_Render::RenderLayer::effect,
+                                    3,
+                                    [&, color, simAlpha]()
+                                    {
+                                        RA_Particle::drawEmitter(confettiBatch,
+                                                                 snapshot.confetti,
+                                                                 snapshot.confettiGrid,
+                                                                 spriteTexture,
+                                                                 particleSprite->uv,
+                                                                 color,
+                                                                 screenRect,
+                                                                 confettiPadding,
+                                                                 simAlpha);
+                                    });
+            };
             switch (currentState)
             {
                 case GameState::none:
@@ -2188,27 +5865,38 @@ auto main([[maybe_unused]] int argc, [[maybe_unused]] char** argv) -> int
                     winUIFramCounter++;
                     // animation of wining
                     constexpr Color const color = WHITE;
-                    RA_Anim::drawAnimCircles(winUIFramCounter,
-                                             winFrameLimit,
-                                             winAnimState,
-                                             winAnimResetFrame,
-                                             10,
-                                             1,
-                                             circles,
-                                             color);
+                    std::size_t const shownCircles = RA_Anim::
+                        updateAnimCircles(winUIFramCounter,
+                                          winFrameLimit,
+                                          winAnimState,
+                                          winAnimResetFrame,
+                                          10,
+                                          1,
+                                          circles.size());
+                    for (std::size_t i = 0; i < shownCircles; ++i)
+                        RA_Render::pushCircle(renderQueue,
+                                              shapeRenderer,
+                                              RA_Render::RenderLayer::effect,
+                                              0,
+                                              circles[i],
+                                              25.f,
+                                              color);
                     if (winUIFramCounter >= 50)
                     {
                         RA_Util::moveTowards(uIPointAnimationWin, circles[0], 500.f);
-                        RA_Util::drawGoodLine(circles[goal - 1],
-                                              uIPointAnimationWin,
-                                              5,
-                                              color);
+                        // 5 units thick line (round caps)
+                        RA_Render::pushCapsule(renderQueue,
+                                               shapeRenderer,
+                                               RA_Render::RenderLayer::effect,
+                                               1,
+                                               circles[goal - 1],
+                                               uIPointAnimationWin,
+                                               2.5f,
+                                               color);
                     }
                     if (winUIFramCounter >= 55)
                     {
-                        RA_Particle::drawParticles(particles,
-                                                   particleRenderTexture.texture,
-                                                   wonPlayer->rectColor);
+                        pushParticles(wonPlayer->rectColor);
                     }
                     if (winUIFramCounter > 70)
                     {
@@ -2218,9 +5906,7 @@ auto main([[maybe_unused]] int argc, [[maybe_unused]] char** argv) -> int
                 }
                 case GameState::tie:
                 {
-                    RA_Particle::drawParticles(particles,
-                                               particleRenderTexture.texture,
-                                               WHITE);
+                    pushParticles(WHITE);
                     break;
                 }
                 case GameState::end:
@@ -2245,38 +5931,95 @@ auto main([[maybe_unused]] int argc, [[maybe_unused]] char** argv) -> int
                                      GREEN);
 #endif
 
-                // draw lables
-                for (auto const & lbl : RA_UI::lablesArray)
-                    RA_UI::drawLable(cast(u32, lbl.id));
-
-                // draw btns
+                // button borders (shapes) under the lables
                 for (auto const & btn : RA_UI::buttonsArray)
-                    RA_UI::drawRoundButton(cast(u32, btn.id));
+                {
+                    if (btn.isHidden || btn.layoutIndx < 0)
+                        continue;
+                    RA_UI::UIRouondLayout const & lay =
+                        RA_UI::layoutArray[cast(u32, btn.layoutIndx)];
+                    if (lay.isHidden)
+                        continue;
+                    // same radius as DrawRectangleRoundedLinesEx roundness
+                    RA_Render::pushRoundedRect(renderQueue,
+                                               shapeRenderer,
+                                               RA_Render::RenderLayer::ui,
+                                               0,
+                                               lay.rect,
+                                               lay.borderRoundness *
+                                                   std::min(lay.rect.width, lay.rect.height) *
+                                                   .5f,
+                                               lay.lineThickness,
+                                               lay.borderColor);
+                }
+                // lables of the buttons are in here too
+                for (auto const & lbl : RA_UI::lablesArray)
+                    RA_Render::pushDraw(renderQueue,
+                                        RA_Render::RenderLayer::ui,
+                                        1,
+                                        [id = cast(u32, lbl.id)]() { RA_UI::drawLable(id); });
+            }
+            {
+                // both passes in the stats of the frame
+                auto const screenStats = RA_Render::submitCommands(renderQueue, commandBatch);
+                renderStats.commandCount += screenStats.commandCount;
+                renderStats.drawCalls += screenStats.drawCalls;
+                renderStats.shaderChanges += screenStats.shaderChanges;
+                renderStats.textureChanges += screenStats.textureChanges;
+                PROFILE_COUNTER("draw calls", renderStats.drawCalls);
+                PROFILE_COUNTER("shader changes", renderStats.shaderChanges);
             }
             // End UI
             EndMode2D();
             EndDrawing();
         }
+        // wait for the next frame (win/tie and cell grow animations run at the
+        // target rate, replay input is not from the device => never idle)
+        frameScheduler.endFrame(currentState != GameState::none ||
+                                    (GetTime() - lastPlacedTime) < cellGrowSeconds ||
+                                    inputSource.mode() == RA_Util::InputMode::Replay,
+                                [&music]() { UpdateMusicStream(music); });
+        if (options->isHeadless)
+        {
+            headlessFrameTimes.push_back(frameScheduler.workSeconds());
+            if (headlessFrameTimes.size() >= options->frameCount)
+                currentState = GameState::end;
+        }
+    }
+    if (options->isHeadless)
+    {
+        auto const stats = RA_Util::makeFrameStats(headlessFrameTimes);
+        std::cout << "headless " << gWidth << 'x' << gHeight << " | "
+                  << headlessFrameTimes.size() << " frames | mean " << stats.meanMs
+                  << " ms (" << (1000.0 / stats.meanMs) << " fps)\n"
+                  << "min " << stats.minMs << " | p50 " << stats.p50Ms << " | p95 "
+                  << stats.p95Ms << " | p99 " << stats.p99Ms << " | max " << stats.maxMs
+                  << " ms\n";
     }
     // clean-up
 
     ClearBackground(BLANK);
     EndDrawing();
     UnloadMusicStream(music);
-    b2DestroyWorld(worldID);
 
-    UnloadTexture(gridTexture);
+    RA_Render::unloadGridRenderer(gridRenderer);
+    RA_Render::unloadShapeRenderer(shapeRenderer);
     UnloadTexture(shapeTexture);
 
-    UnloadRenderTexture(particleRenderTexture);
-    UnloadRenderTexture(mainRenderTexture);
+    RA_Render::unloadTextureAtlas(spriteAtlas);
+    RA_Render::unloadQuadBatch(confettiBatch);
+    RA_Render::unloadQuadBatch(commandBatch);
+    RA_Render::unloadDynamicResolution(mainResolution);
+    RA_Render::unloadCachedLayer(backgroundLayer);
 
     UnloadFont(font);
 
     UnloadShader(backgroundShader);
-    UnloadShader(circleShader);
-    UnloadShader(crossShader);
+    UnloadShader(cellShader);
 
-    CloseAudioDevice();
+    if (!inputSource.finish())
+        std::cerr << "Error: can not write " << options->recordPath << '\n';
+    if (!options->isHeadless)
+        CloseAudioDevice();
     CloseWindow();
 }
\ No newline at end of file
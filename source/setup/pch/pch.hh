@@ -12,6 +12,8 @@
 #ifndef PCH_HH  // PCH_HH
 #define PCH_HH
 
+// HEADLESS_BUILD targets (simulator, tools) dont have raylib and box2d
+#if !defined(HEADLESS_BUILD)
 // box2d headers
 #include <box2d/box2d.h>
 
@@ -20,6 +22,7 @@
 #include <raylib.h>
 #include <raymath.h>
 #include <rlgl.h>
+#endif
 
 // C++ headers
 #include <iostream>
@@ -27,6 +30,7 @@
 #include <string_view>
 #include <fstream>
 #include <chrono>
+#include <ctime>
 #include <mutex>
 #include <algorithm>
 #include <random>
@@ -35,11 +39,23 @@
 #include <vector>
 #include <array>
 #include <optional>
+#include <functional>
+#include <charconv>
 #include <bitset>
 #include <thread>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
 #include <fstream>
 #include <cassert>
 #include <cstdint>
+#include <cstring>
+#include <bit>
+
+// simd intrinsics (x86 only, others use scalar code)
+#if defined(__SSE2__) && (defined(__x86_64__) || defined(__i386__))
+#include <immintrin.h>
+#endif
 
 // Project generated header for config macro nad variables
 #include "config.hh"
@@ -52,6 +68,10 @@
 // include your internall headers hear
 #if INERNAL_LIB == 1
 #include "Log.hh"
+#include "GameCore.hh"
+#include "SelfPlay.hh"
+#include "BatchEval.hh"
+#include "SolutionDB.hh"
 #endif
 
 #endif  // PCH_HH
\ No newline at end of file
@@ -0,0 +1,280 @@
+/*
+ * Copyright (C) 2024 RealAhani - All Rights Reserved
+ * You may use, distribute and modify this code under the
+ * terms of the MIT license, which unfortunately won't be
+ * written for another century.
+ * You should have received a copy of the MIT license with
+ * this file.
+ */
+
+#include <charconv>
+
+namespace
+{
+using namespace std::string_view_literals;
+
+namespace RA_Sim
+{
+
+struct Options
+{
+    u64   games {1'000'000};
+    u8    columnCount {3};
+    u8    rowCount {3};
+    u8    goal {3};
+    str_v first {"random"sv};
+    str_v second {"random"sv};
+    u32   threadCount {std::max(std::thread::hardware_concurrency(), 1U)};
+    u64   seed {0x5EED};
+    u64   batchSize {0};  // positions for batch evaluation benchmark (0 = off)
+    str_v database {};    // solution database for the perfect policy
+};
+
+[[maybe_unused]]
+auto printUsage() noexcept -> void
+{
+    std::cout << "usage: simulator [--games n] [--columns n] [--rows n] [--goal n]\n"
+                 "                 [--first random|ai|perfect] [--second random|ai|perfect]\n"
+                 "                 [--threads n] [--seed n] [--batch n] [--db path]\n";
+}
+
+/*
+ *@Goal: parse an unsigned number from cli argument
+ */
+template <typename T>
+[[nodiscard]] [[maybe_unused]]
+auto parseNumber(str_v const text, T & outValue) noexcept -> bool
+{
+    u64 value {};
+    auto const [ptr, ec] = std::from_chars(text.data(), text.data() + text.size(), value);
+    if (ec != std::errc {} || ptr != text.data() + text.size() ||
+        value > std::numeric_limits<T>::max())
+        return false;
+    outValue = cast(T, value);
+    return true;
+}
+
+/*
+ *@Goal: fill the options from cli args
+ *@Note: return nullopt if some args are not valid
+ */
+[[nodiscard]] [[maybe_unused]]
+auto parseOptions(std::span<char*> const args) noexcept -> std::optional<Options>
+{
+    Options options {};
+    for (std::size_t i = 1; i < args.size(); ++i)
+    {
+        str_v const key = args[i];
+        if (key == "--help"sv || (i + 1) >= args.size())
+            return std::nullopt;
+        str_v const value = args[++i];
+
+        bool isValid {true};
+        if (key == "--games"sv)
+            isValid = parseNumber(value, options.games);
+        else if (key == "--columns"sv)
+            isValid = parseNumber(value, options.columnCount);
+        else if (key == "--rows"sv)
+            isValid = parseNumber(value, options.rowCount);
+        else if (key == "--goal"sv)
+            isValid = parseNumber(value, options.goal);
+        else if (key == "--first"sv)
+            options.first = value;
+        else if (key == "--second"sv)
+            options.second = value;
+        else if (key == "--threads"sv)
+            isValid = parseNumber(value, options.threadCount);
+        else if (key == "--seed"sv)
+            isValid = parseNumber(value, options.seed);
+        else if (key == "--batch"sv)
+            isValid = parseNumber(value, options.batchSize);
+        else if (key == "--db"sv)
+            options.database = value;
+        else
+            isValid = false;
+
+        if (!isValid)
+        {
+            std::cerr << "Error: invalid argument " << key << ' ' << value << '\n';
+            return std::nullopt;
+        }
+    }
+
+    // the rules engine work on 64bit bitboards
+    if (options.columnCount < 2 || options.rowCount < 2 ||
+        (options.columnCount * options.rowCount) > RA_Game::maxCells ||
+        options.goal < 2 || options.goal > std::max(options.columnCount, options.rowCount))
+    {
+        std::cerr << "Error: board should be at least 2x2, at most 64 cells and "
+                     "2 <= goal <= max(columns, rows)\n";
+        return std::nullopt;
+    }
+    return options;
+}
+
+[[maybe_unused]]
+auto printStats(Options const &              options,
+                RA_Game::SelfPlayStats const & stats,
+                f64 const                    seconds) noexcept -> void
+{
+    auto const percent = [&stats](u64 const count) -> f64
+    {
+        return (stats.games == 0) ? 0.0
+                                  : (cast(f64, count) * 100.0 / cast(f64, stats.games));
+    };
+
+    std::cout << "board " << +options.columnCount << 'x' << +options.rowCount
+              << " goal " << +options.goal << " | " << options.first << " vs "
+              << options.second << " | " << stats.games << " games on "
+              << options.threadCount << " threads\n";
+    std::cout << "first won : " << stats.firstWins << " (" << percent(stats.firstWins)
+              << "%)\n";
+    std::cout << "second won: " << stats.secondWins << " ("
+              << percent(stats.secondWins) << "%)\n";
+    std::cout << "tie       : " << stats.ties << " (" << percent(stats.ties) << "%)\n";
+    std::cout << "average length: "
+              << ((stats.games == 0)
+                      ? 0.0
+                      : (cast(f64, stats.totalMoves) / cast(f64, stats.games)))
+              << " moves\n";
+    std::cout << "length histogram:\n";
+    for (std::size_t length = 0; length < stats.lengthHistogram.size(); ++length)
+    {
+        if (stats.lengthHistogram[length] == 0)
+            continue;
+        std::cout << "  " << length << " moves: " << stats.lengthHistogram[length]
+                  << " (" << percent(stats.lengthHistogram[length]) << "%)\n";
+    }
+    std::cout << "time: " << seconds << " s | "
+              << (cast(f64, stats.games) / seconds) << " games/s | "
+              << (cast(f64, stats.totalMoves) / seconds) << " moves/s\n";
+}
+
+/*
+ *@Goal: legal positions from random playouts that stop at a random ply
+ *@Note: output is SoA (first and second bitboards) like the batch kernel wants
+ */
+[[maybe_unused]]
+auto randomPositions(RA_Game::Variant const & variant,
+                     u64 const                count,
+                     RA_Game::FastRandom &    rng,
+                     std::vector<u64> &       outFirst,
+                     std::vector<u64> &       outSecond) -> void
+{
+    outFirst.resize(count);
+    outSecond.resize(count);
+    for (u64 i = 0; i < count; ++i)
+    {
+        RA_Game::Board board {};
+        u32 const      plies = rng.below(cast(u32, variant.cellCount) + 1);
+        for (u32 ply = 0; ply < plies && RA_Game::status(board) == RA_Game::EOutcome::none;
+             ++ply)
+        {
+            (void)RA_Game::applyMove(board,
+                                     variant,
+                                     RA_Game::randomPolicy(board, variant, rng));
+        }
+        outFirst[i]  = board.moves[0];
+        outSecond[i] = board.moves[1];
+    }
+}
+
+/*
+ *@Goal: throughput of the batch win/tie kernel for each simd level
+ *@Note: every level should give the same result as scalar
+ */
+[[nodiscard]] [[maybe_unused]]
+auto benchmarkBatch(Options const & options, RA_Game::Variant const & variant) -> bool
+{
+    PROFILE();
+    RA_Game::FastRandom rng {options.seed};
+    std::vector<u64>    first;
+    std::vector<u64>    second;
+    randomPositions(variant, options.batchSize, rng, first, second);
+
+    std::vector<RA_Game::EOutcome> reference(options.batchSize);
+    std::vector<RA_Game::EOutcome> outcomes(options.batchSize);
+    constexpr std::array<std::pair<RA_Game::ESimdLevel, str_v>, 3> const levels {
+        {{RA_Game::ESimdLevel::scalar, "scalar"sv},
+         {RA_Game::ESimdLevel::sse2, "sse2"sv},
+         {RA_Game::ESimdLevel::avx2, "avx2"sv}}};
+
+    bool isSame {true};
+    for (auto const & [level, name] : levels)
+    {
+        if (level > RA_Game::bestSimdLevel())
+            break;
+        auto & out = (level == RA_Game::ESimdLevel::scalar) ? reference : outcomes;
+        auto const start = std::chrono::steady_clock::now();
+        RA_Game::evaluateBatch(first, second, variant, out, level);
+        std::chrono::duration<f64> const elapsed = std::chrono::steady_clock::now() -
+                                                   start;
+        bool const isLevelSame = (out == reference);
+        isSame                 = isSame && isLevelSame;
+        std::cout << "batch " << name << ": " << options.batchSize << " positions | "
+                  << (cast(f64, options.batchSize) / elapsed.count())
+                  << " positions/s | " << (isLevelSame ? "same as scalar" : "MISMATCH")
+                  << '\n';
+    }
+    return isSame;
+}
+
+}  // namespace RA_Sim
+}  // namespace
+
+
+auto main(int argc, char** argv) -> int
+{
+    auto const options = RA_Sim::parseOptions(
+        std::span<char*> {argv, cast(std::size_t, argc)});
+    if (!options.has_value())
+    {
+        RA_Sim::printUsage();
+        return 1;
+    }
+
+    RA_Game::PolicyFn const first  = RA_Game::findPolicy(options->first);
+    RA_Game::PolicyFn const second = RA_Game::findPolicy(options->second);
+    if (first == nullptr || second == nullptr)
+    {
+        std::cerr << "Error: unknown policy (random, ai, perfect)\n";
+        return 1;
+    }
+
+    RA_Game::Variant const variant = RA_Game::makeVariant(options->columnCount,
+                                                          options->rowCount,
+                                                          options->goal);
+
+    // without database the perfect policy play like ai
+    RA_Game::SolutionTable table {};
+    if (!options->database.empty())
+    {
+        if (!table.open(str {options->database}, variant))
+        {
+            std::cerr << "Error: " << options->database
+                      << " is not a solution database of this board\n";
+            return 1;
+        }
+        RA_Game::bindSolutionTable(&table);
+    }
+
+    RA_Game::SelfPlayConfig const config {.first       = first,
+                                          .second      = second,
+                                          .games       = options->games,
+                                          .threadCount = options->threadCount,
+                                          .seed        = options->seed};
+
+    auto const start = std::chrono::steady_clock::now();
+    RA_Game::SelfPlayStats stats {};
+    {
+        PROFILE_SCOPE("self-play");
+        stats = RA_Game::runSelfPlay(variant, config);
+    }
+    std::chrono::duration<f64> const elapsed = std::chrono::steady_clock::now() - start;
+
+    RA_Sim::printStats(*options, stats, elapsed.count());
+
+    if (options->batchSize > 0 && !RA_Sim::benchmarkBatch(*options, variant))
+        return 1;
+    return 0;
+}
@@ -0,0 +1,157 @@
+/*
+ * Copyright (C) 2024 RealAhani - All Rights Reserved
+ * You may use, distribute and modify this code under the
+ * terms of the MIT license, which unfortunately won't be
+ * written for another century.
+ * You should have received a copy of the MIT license with
+ * this file.
+ */
+
+#include <charconv>
+
+namespace
+{
+using namespace std::string_view_literals;
+
+namespace RA_Solver
+{
+
+struct Options
+{
+    u8  columnCount {3};
+    u8  rowCount {3};
+    u8  goal {3};
+    str output {};  // default: solution_<columns>x<rows>_<goal>.db
+};
+
+[[maybe_unused]]
+auto printUsage() noexcept -> void
+{
+    std::cout << "usage: solver [--columns n] [--rows n] [--goal n] [--out path]\n";
+}
+
+/*
+ *@Goal: parse a small unsigned number from cli argument
+ */
+[[nodiscard]] [[maybe_unused]]
+auto parseNumber(str_v const text, u8 & outValue) noexcept -> bool
+{
+    u32 value {};
+    auto const [ptr, ec] = std::from_chars(text.data(), text.data() + text.size(), value);
+    if (ec != std::errc {} || ptr != text.data() + text.size() ||
+        value > std::numeric_limits<u8>::max())
+        return false;
+    outValue = cast(u8, value);
+    return true;
+}
+
+/*
+ *@Goal: fill the options from cli args
+ *@Note: return nullopt if some args are not valid
+ */
+[[nodiscard]] [[maybe_unused]]
+auto parseOptions(std::span<char*> const args) -> std::optional<Options>
+{
+    Options options {};
+    for (std::size_t i = 1; i < args.size(); ++i)
+    {
+        str_v const key = args[i];
+        if (key == "--help"sv || (i + 1) >= args.size())
+            return std::nullopt;
+        str_v const value = args[++i];
+
+        bool isValid {true};
+        if (key == "--columns"sv)
+            isValid = parseNumber(value, options.columnCount);
+        else if (key == "--rows"sv)
+            isValid = parseNumber(value, options.rowCount);
+        else if (key == "--goal"sv)
+            isValid = parseNumber(value, options.goal);
+        else if (key == "--out"sv)
+            options.output = value;
+        else
+            isValid = false;
+
+        if (!isValid)
+        {
+            std::cerr << "Error: invalid argument " << key << ' ' << value << '\n';
+            return std::nullopt;
+        }
+    }
+
+    // canonical keys pack both bitboards in one u64
+    if (options.columnCount < 2 || options.rowCount < 2 ||
+        (options.columnCount * options.rowCount) > RA_Game::maxSolvedCells ||
+        options.goal < 2 || options.goal > std::max(options.columnCount, options.rowCount))
+    {
+        std::cerr << "Error: board should be at least 2x2, at most 32 cells and "
+                     "2 <= goal <= max(columns, rows)\n";
+        return std::nullopt;
+    }
+    if (options.output.empty())
+    {
+        options.output = "solution_" + std::to_string(options.columnCount) + 'x' +
+                         std::to_string(options.rowCount) + '_' +
+                         std::to_string(options.goal) + ".db";
+    }
+    return options;
+}
+
+}  // namespace RA_Solver
+}  // namespace
+
+
+auto main(int argc, char** argv) -> int
+{
+    auto const options = RA_Solver::parseOptions(
+        std::span<char*> {argv, cast(std::size_t, argc)});
+    if (!options.has_value())
+    {
+        RA_Solver::printUsage();
+        return 1;
+    }
+
+    RA_Game::Variant const variant = RA_Game::makeVariant(options->columnCount,
+                                                          options->rowCount,
+                                                          options->goal);
+
+    auto const start = std::chrono::steady_clock::now();
+    std::vector<std::pair<u64, u16>> entries;
+    {
+        PROFILE_SCOPE("solve");
+        entries = RA_Game::solveVariant(variant);
+    }
+    std::chrono::duration<f64> const elapsed = std::chrono::steady_clock::now() - start;
+
+    if (!RA_Game::writeSolutionTable(options->output, variant, entries))
+    {
+        std::cerr << "Error: can not write " << options->output << '\n';
+        return 1;
+    }
+
+    // read back the written file (same path the game/ai use)
+    RA_Game::SolutionTable table {};
+    if (!table.open(options->output, variant))
+    {
+        std::cerr << "Error: can not map " << options->output << '\n';
+        return 1;
+    }
+    auto const root = table.lookup(RA_Game::Board {});
+
+    constexpr std::array<str_v, 3> const results {"second player wins"sv,
+                                                  "tie"sv,
+                                                  "first player wins"sv};
+    std::cout << "board " << +options->columnCount << 'x' << +options->rowCount << " goal "
+              << +options->goal << " | " << entries.size() << " canonical positions | "
+              << elapsed.count() << " s\n";
+    if (root.has_value())
+    {
+        std::cout << "empty board: " << results[cast(std::size_t, root->value + 1)]
+                  << " in " << +root->plies << " moves\n";
+    }
+    std::cout << "written: " << options->output << " ("
+              << (sizeof(RA_Game::SolutionHeader) +
+                  entries.size() * (sizeof(u64) + sizeof(u16)))
+              << " bytes)\n";
+    return 0;
+}
@@ -0,0 +1,75 @@
+/*
+ * Copyright (C) 2024 RealAhani - All Rights Reserved
+ * You may use, distribute and modify this code under the
+ * terms of the MIT license, which unfortunately won't be
+ * written for another century.
+ * You should have received a copy of the MIT license with
+ * this file.
+ */
+
+#include "GameCore.hh"
+#include "SelfPlay.hh"
+#include "BatchEval.hh"
+#include <catch2/catch_test_macros.hpp>
+
+
+TEST_CASE("simd batch evaluation is same as scalar", "[batcheval]")
+{
+    RA_Game::FastRandom rng {7};
+    for (auto const & variant : {RA_Game::makeVariant(3, 3, 3),
+                                 RA_Game::makeVariant(4, 4, 4),
+                                 RA_Game::makeVariant(8, 8, 5)})
+    {
+        // random bitboards (also impossible ones like both players won)
+        // odd size => the scalar tail is tested too
+        constexpr std::size_t const count {1027};
+        std::vector<u64>            first(count);
+        std::vector<u64>            second(count);
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            first[i]  = rng.next() & variant.fullMask;
+            second[i] = (rng.next() & variant.fullMask) & ~first[i];
+        }
+        first[0]  = variant.fullMask;  // both won
+        second[0] = variant.fullMask;
+        first[1]  = 0;  // just second has a line
+        second[1] = variant.winMasks.front();
+
+        std::vector<RA_Game::EOutcome> reference(count);
+        RA_Game::evaluateBatchScalar(first, second, variant, reference);
+        REQUIRE(reference[0] == RA_Game::EOutcome::firstWon);
+        REQUIRE(reference[1] == RA_Game::EOutcome::secondWon);
+
+        for (auto const level : {RA_Game::ESimdLevel::sse2, RA_Game::ESimdLevel::avx2})
+        {
+            std::vector<RA_Game::EOutcome> outcomes(count);
+            RA_Game::evaluateBatch(first, second, variant, outcomes, level);
+            REQUIRE(outcomes == reference);
+        }
+    }
+}
+
+TEST_CASE("batch evaluation match the rules engine", "[batcheval]")
+{
+    auto const          variant = RA_Game::makeVariant(3, 3, 3);
+    RA_Game::FastRandom rng {11};
+    std::vector<u64>    first;
+    std::vector<u64>    second;
+    std::vector<RA_Game::EOutcome> expected;
+    for (u32 game = 0; game < 200; ++game)
+    {
+        RA_Game::Board board {};
+        while (RA_Game::status(board) == RA_Game::EOutcome::none)
+        {
+            (void)RA_Game::applyMove(board,
+                                     variant,
+                                     RA_Game::randomPolicy(board, variant, rng));
+            first.emplace_back(board.moves[0]);
+            second.emplace_back(board.moves[1]);
+            expected.emplace_back(RA_Game::status(board));
+        }
+    }
+    std::vector<RA_Game::EOutcome> outcomes(expected.size());
+    RA_Game::evaluateBatch(first, second, variant, outcomes);
+    REQUIRE(outcomes == expected);
+}
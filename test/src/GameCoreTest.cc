@@ -0,0 +1,78 @@
+/*
+ * Copyright (C) 2024 RealAhani - All Rights Reserved
+ * You may use, distribute and modify this code under the
+ * terms of the MIT license, which unfortunately won't be
+ * written for another century.
+ * You should have received a copy of the MIT license with
+ * this file.
+ */
+
+#include "GameCore.hh"
+#include "SelfPlay.hh"
+#include <catch2/catch_test_macros.hpp>
+
+
+TEST_CASE("win lines of the variants", "[gamecore]")
+{
+    // same as the old hard coded winTable of 3x3 (bit order does not matter)
+    auto const variant3x3 = RA_Game::makeVariant(3, 3, 3);
+    REQUIRE(variant3x3.cellCount == 9);
+    REQUIRE(variant3x3.fullMask == 0x1FF);
+    REQUIRE(variant3x3.winMasks.size() == 8);
+    for (u64 const mask :
+         std::array<u64, 8> {0x007, 0x038, 0x049, 0x054, 0x092, 0x111, 0x124, 0x1c0})
+        REQUIRE(std::ranges::find(variant3x3.winMasks, mask) != variant3x3.winMasks.end());
+
+    REQUIRE(RA_Game::makeVariant(4, 4, 4).winMasks.size() == 10);
+    REQUIRE(RA_Game::makeVariant(4, 4, 3).winMasks.size() == 24);
+}
+
+TEST_CASE("apply move and status", "[gamecore]")
+{
+    auto const     variant = RA_Game::makeVariant(3, 3, 3);
+    RA_Game::Board board {};
+
+    // first: 0 1 2 (top row) second: 3 4
+    REQUIRE(RA_Game::applyMove(board, variant, 0));
+    REQUIRE(board.turn == 1);
+    REQUIRE_FALSE(RA_Game::applyMove(board, variant, 0));  // not free
+    REQUIRE_FALSE(RA_Game::applyMove(board, variant, 9));  // out of board
+    REQUIRE(RA_Game::applyMove(board, variant, 3));
+    REQUIRE(RA_Game::applyMove(board, variant, 1));
+    REQUIRE(RA_Game::applyMove(board, variant, 4));
+    REQUIRE(RA_Game::status(board) == RA_Game::EOutcome::none);
+    REQUIRE(RA_Game::applyMove(board, variant, 2));
+    REQUIRE(RA_Game::status(board) == RA_Game::EOutcome::firstWon);
+    REQUIRE(RA_Game::winningLine(board, variant) == 0x007);
+    REQUIRE(RA_Game::legalMoves(board, variant) == 0);
+    REQUIRE_FALSE(RA_Game::applyMove(board, variant, 8));  // game is finished
+
+    RA_Game::reset(board);
+    REQUIRE(RA_Game::status(board) == RA_Game::EOutcome::none);
+    REQUIRE(RA_Game::occupied(board) == 0);
+    REQUIRE(board.turn == 0);
+
+    // tie: X O X / X O O / O X X
+    for (u8 const cell : std::array<u8, 9> {0, 1, 2, 4, 3, 5, 7, 6, 8})
+        REQUIRE(RA_Game::applyMove(board, variant, cell));
+    REQUIRE(RA_Game::status(board) == RA_Game::EOutcome::tie);
+}
+
+TEST_CASE("self-play is deterministic and complete", "[selfplay]")
+{
+    auto const variant = RA_Game::makeVariant(3, 3, 3);
+    RA_Game::SelfPlayConfig const config {.first       = RA_Game::findPolicy("random"),
+                                          .second      = RA_Game::findPolicy("ai"),
+                                          .games       = 1000,
+                                          .threadCount = 4,
+                                          .seed        = 42};
+    REQUIRE(RA_Game::findPolicy("unknown") == nullptr);
+
+    auto const first  = RA_Game::runSelfPlay(variant, config);
+    auto const second = RA_Game::runSelfPlay(variant, config);
+    REQUIRE(first.games == 1000);
+    REQUIRE(first.firstWins + first.secondWins + first.ties == first.games);
+    REQUIRE(first.firstWins == second.firstWins);
+    REQUIRE(first.ties == second.ties);
+    REQUIRE(first.lengthHistogram == second.lengthHistogram);
+}
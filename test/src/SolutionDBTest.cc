@@ -0,0 +1,77 @@
+/*
+ * Copyright (C) 2024 RealAhani - All Rights Reserved
+ * You may use, distribute and modify this code under the
+ * terms of the MIT license, which unfortunately won't be
+ * written for another century.
+ * You should have received a copy of the MIT license with
+ * this file.
+ */
+
+#include "GameCore.hh"
+#include "SelfPlay.hh"
+#include "SolutionDB.hh"
+#include <catch2/catch_test_macros.hpp>
+#include <filesystem>
+
+
+TEST_CASE("symmetric boards have the same key", "[solutiondb]")
+{
+    auto const variant    = RA_Game::makeVariant(3, 3, 3);
+    auto const symmetries = RA_Game::makeSymmetries(variant);
+    REQUIRE(symmetries.count == 8);
+    REQUIRE(RA_Game::makeSymmetries(RA_Game::makeVariant(4, 3, 3)).count == 4);
+
+    // first on a corner => every corner is the same position
+    u8         symmetry {};
+    u64 const  key = RA_Game::canonicalKey(1U << 0, 0, symmetries, symmetry);
+    for (u32 const corner : {2U, 6U, 8U})
+        REQUIRE(RA_Game::canonicalKey(1U << corner, 0, symmetries, symmetry) == key);
+    REQUIRE(RA_Game::canonicalKey(1U << 4, 0, symmetries, symmetry) != key);
+}
+
+TEST_CASE("solved 3x3 table from the mapped file", "[solutiondb]")
+{
+    auto const variant = RA_Game::makeVariant(3, 3, 3);
+    auto const entries = RA_Game::solveVariant(variant);
+    REQUIRE(entries.size() == 765);  // canonical positions (symmetries merged)
+    REQUIRE(std::ranges::is_sorted(entries, {}, &std::pair<u64, u16>::first));
+
+    auto const path = (std::filesystem::temp_directory_path() / "solution_test_3x3.db")
+                          .string();
+    REQUIRE(RA_Game::writeSolutionTable(path, variant, entries));
+
+    {  // unmap before remove
+        RA_Game::SolutionTable table {};
+        REQUIRE_FALSE(table.open(path, RA_Game::makeVariant(4, 4, 4)));  // other variant
+        REQUIRE(table.open(path, variant));
+        REQUIRE(table.size() == entries.size());
+
+        // perfect play is a tie
+        RA_Game::Board board {};
+        auto const     root = table.lookup(board);
+        REQUIRE(root.has_value());
+        REQUIRE(root->value == 0);
+        REQUIRE(root->plies == 9);
+
+        // first: 0 4, second: 1 2 => first should win on 8 (in original cell order)
+        for (u8 const cell : std::array<u8, 4> {0, 1, 4, 2})
+            REQUIRE(RA_Game::applyMove(board, variant, cell));
+        auto const win = table.lookup(board);
+        REQUIRE(win.has_value());
+        REQUIRE(win->value == 1);
+        REQUIRE(win->plies == 1);
+        REQUIRE(win->bestMove == 8);
+
+        // perfect player never lose
+        RA_Game::bindSolutionTable(&table);
+        RA_Game::SelfPlayConfig const config {.first       = RA_Game::findPolicy("perfect"),
+                                              .second      = RA_Game::findPolicy("random"),
+                                              .games       = 1000,
+                                              .threadCount = 2,
+                                              .seed        = 7};
+        auto const stats = RA_Game::runSelfPlay(variant, config);
+        REQUIRE(stats.secondWins == 0);
+        RA_Game::bindSolutionTable(nullptr);
+    }
+    std::filesystem::remove(path);
+}